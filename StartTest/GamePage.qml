@@ -9,16 +9,17 @@ Item {
 
     signal goBack()
 
-    property int opponentsCount: 0
-    property string lastDiscard: ""
-    property string lastDiscardId: ""
-    property int lastHandCount: 0
-    property int lastDrawCount: 0
-    property string cardBase: "qrc:/assets/images/cards/"
+    // Direkt an die einzelnen Properties gebunden: ändert sich nur die Ablage, wird nur die Ablage neu berechnet
+    // Zuschauer haben keinen eigenen Platz, also sind alle Spieler "Gegner"
+    property int opponentsCount: gameClient.spectating ? gameClient.players : Math.max(0, gameClient.players - 1)
+    property string lastDiscard: cardSource(gameClient.discardTop)
+    property string lastDiscardId: normalizeCardName(gameClient.discardTop)
+    property int lastHandCount: gameClient.hand.count
+    property int lastDrawCount: gameClient.drawCount
+    property string cardBase: "image://cards/"
     property string pendingWildCard: ""
     property bool unoDeclared: false
     property bool endPopupShown: false
-    property var graphData: []
 
     // Normalisiert alte Namen: "Blau 2" -> "Blau_2.jpg"
     // lässt neue Namen wie "Blau_2.jpg" unverändert
@@ -38,52 +39,44 @@ Item {
         return s
     }
 
-    //Erstellt den Pfad zu jeder Karte
-    function fileToQrc(fileName) {
+    //Erstellt den Pfad zu jeder Karte (Ausschnitt aus dem Karten-Atlas)
+    function cardSource(fileName) {
         var n = normalizeCardName(fileName)
         if (n.length === 0) return ""
         return cardBase + n
     }
 
-    //Berechnet und setzt den Stand der Variablen die Fürs Ende benötigt werden (opponentsCount, endPopupShown) am Ende des Spiels
-    function applyStateFromClient() {
-        if (!gameClient.hasGameInit) return
-
-        lastDiscard = fileToQrc(gameClient.discardTop)
-        lastDiscardId = normalizeCardName(gameClient.discardTop)
-        opponentsCount = Math.max(0, gameClient.players - 1)
-
-        // Debug/Status
-        lastHandCount = gameClient.hand ? gameClient.hand.length : 0
-        lastDrawCount = gameClient.drawCount
+    onLastHandCountChanged: {
         if (lastHandCount !== 1) {
             unoDeclared = false
         }
+    }
 
-        if (gameClient.finished) {
-            if (gameClient.winnerIndex === gameClient.yourIndex) {
-                infoBanner.show("Spiel beendet! Du hast gewonnen.")
-            } else if (gameClient.winnerIndex >= 0) {
-                infoBanner.show("Spiel beendet! Gewinner: Spieler " + (gameClient.winnerIndex + 1))
-            } else {
-                infoBanner.show("Spiel beendet!")
-            }
-            if (!endPopupShown) {
-                endPopupShown = true
-                graphData = buildGraphData(gameClient.gameLog, gameClient.players)
-                gameGraph.requestPaint()
-                endGamePopup.open()
-            }
+    //Zeigt am Ende des Spiels den Gewinner und öffnet einmalig das Popup mit dem Verlauf
+    function showGameFinished() {
+        if (!gameClient.hasGameInit || !gameClient.finished) return
+
+        if (gameClient.winnerIndex === gameClient.yourIndex) {
+            infoBanner.show("Spiel beendet! Du hast gewonnen.")
+        } else if (gameClient.winnerIndex >= 0) {
+            infoBanner.show("Spiel beendet! Gewinner: Spieler " + (gameClient.winnerIndex + 1))
+        } else {
+            infoBanner.show("Spiel beendet!")
+        }
+        if (!endPopupShown) {
+            endPopupShown = true
+            endGamePopup.open()
         }
     }
 
-    //Ruft erst am Ende des Component die Methode darüber auf, um die ganzen Variablen fürs Spielende zu setzen
-    Component.onCompleted: applyStateFromClient()
+    //Falls die Seite erst nach Spielende geöffnet wird
+    Component.onCompleted: showGameFinished()
 
-    // Reagiere zentral auf Verbindungen
+    // Nur auf die Signale hören, die hier wirklich etwas auslösen
     Connections {
         target: gameClient
-        function onGameStateChanged() { applyStateFromClient() }
+        function onFinishedChanged() { showGameFinished() }
+        function onWinnerIndexChanged() { showGameFinished() }
         function onError(msg) { infoBanner.show("Server: " + msg) }
     }
 
@@ -175,7 +168,7 @@ Item {
             model: opponentsCount
             delegate: Item {
                 height: 130
-                property int globalIndex: index < gameClient.yourIndex ? index : index + 1
+                property int globalIndex: gameClient.spectating || index < gameClient.yourIndex ? index : index + 1
                 property int cardCount: gameClient.handCounts.length > globalIndex ? gameClient.handCounts[globalIndex] : 0
                 width: Math.max(90, cardCount * 70)
 
@@ -186,7 +179,9 @@ Item {
                         delegate: Image {
                             width: 60
                             height: 90
-                            source: "qrc:/assets/images/cards/Gegnerkarte.jpg"
+                            source: cardBase + "Gegnerkarte"
+                            // Provider liefert genau diese Größe (mal devicePixelRatio), kein Herunterskalieren im GUI-Thread
+                            sourceSize: Qt.size(width, height)
                             fillMode: Image.PreserveAspectFit
                             smooth: true
                         }
@@ -218,23 +213,16 @@ Item {
             color: "white"; border.color: "black"; border.width: 2
 
             // Zuletzt gelegte Karte in der Mitte des Bildschirms
-            // Discard (mit Fallback .png <-> .jpg falls mal inkonsistent)
+            // Discard (Ausschnitt aus dem Karten-Atlas)
             Image {
                 id: discardImg
                 anchors.fill: parent
                 anchors.margins: 6
                 source: lastDiscard
+                sourceSize: Qt.size(width, height)
                 visible: lastDiscard !== ""
                 fillMode: Image.PreserveAspectFit
                 smooth: true
-
-                onStatusChanged: {
-                    if (status === Image.Error && source.indexOf(".png") !== -1) {
-                        source = source.replace(".png", ".jpg")
-                    } else if (status === Image.Error && source.indexOf(".jpg") !== -1) {
-                        source = source.replace(".jpg", ".png")
-                    }
-                }
             }
 
             Text {
@@ -269,7 +257,7 @@ Item {
         }
     }
 
-    // Hand (unten) – direkt aus gameClient.hand (kein extra ListModel nötig)
+    // Hand (unten) – HandModel aus C++: eine gezogene Karte erzeugt genau einen Delegate
     Row {
         id: playerHand
         spacing: 18
@@ -298,15 +286,8 @@ Item {
                         fillMode: Image.PreserveAspectFit
                         smooth: true
 
-                        property string originalName: modelData
-                        source: fileToQrc(originalName)
-
-                        // Fallback, falls irgendwo doch noch .png/.jpg nicht passt
-                        onStatusChanged: {
-                            if (status !== Image.Error) return
-                            if (source.indexOf(".png") !== -1) source = source.replace(".png", ".jpg")
-                            else if (source.indexOf(".jpg") !== -1) source = source.replace(".jpg", ".png")
-                        }
+                        source: model.imageSource
+                        sourceSize: Qt.size(width, height)
                     }
 
                     MouseArea {
@@ -317,16 +298,16 @@ Item {
                                 infoBanner.show("Nicht dein Zug.")
                                 return
                             }
-                            if (!isLegalCard(modelData)) {
+                            if (!model.playable) {
                                 infoBanner.show("Diese Karte ist nicht erlaubt.")
                                 return
                             }
-                            if (requiresColor(modelData)) {
-                                pendingWildCard = modelData
+                            if (model.needsColor) {
+                                pendingWildCard = model.cardId
                                 colorPicker.open()
                                 return
                             }
-                            gameClient.playCard(modelData)
+                            gameClient.playCard(model.cardId)
                         }
                     }
                 }
@@ -344,7 +325,7 @@ Item {
         anchors.bottom: parent.bottom
         anchors.rightMargin: 30
         anchors.bottomMargin: 120
-        visible: gameClient.hasGameInit && !gameClient.finished && gameClient.hand.length === 1
+        visible: gameClient.hasGameInit && !gameClient.finished && gameClient.hand.count === 1
         enabled: !unoDeclared
 
         background: Rectangle {
@@ -364,17 +345,25 @@ Item {
     //Dialogfeld am Ende um die File zu speichern
     FileDialog {
         id: logFileDialog
-        title: "CSV speichern"
-        nameFilters: ["CSV Dateien (*.csv)"]
+        title: "Log speichern"
+        // Format ergibt sich aus der Endung (siehe LogExporter::formatForPath)
+        nameFilters: ["CSV Dateien (*.csv)", "CSV komprimiert (*.csv.gz)", "Binär-Log (*.unolog)"]
         fileMode: FileDialog.SaveFile
         onAccepted: {
             if (!gameClient.saveGameLog(logFileDialog.file)) {
-                infoBanner.show("CSV konnte nicht gespeichert werden.")
-            } else {
-                infoBanner.show("CSV gespeichert.")
+                infoBanner.show("Log konnte nicht gespeichert werden.")
             }
         }
     }
+
+    // Export läuft im Hintergrund, Ergebnis kommt hier an
+    Connections {
+        target: gameClient.logExporter
+        function onFinished(ok, message) {
+            infoBanner.show(ok ? "Log gespeichert: " + message
+                               : "Log konnte nicht gespeichert werden: " + message)
+        }
+    }
     //Zeigt das Popup am Ende des Spiels an, wo drinnen steht ob man gewonnen oder verloren hat
     Popup {
         id: endGamePopup
@@ -406,8 +395,10 @@ Item {
             }
 
             Button {
-                text: "CSV herunterladen"
-                enabled: gameClient.hasGameLog
+                text: gameClient.logExporter.busy
+                      ? "Speichere... " + Math.round(gameClient.logExporter.progress * 100) + "%"
+                      : "CSV herunterladen"
+                enabled: gameClient.hasGameLog && !gameClient.logExporter.busy
                 onClicked: logFileDialog.open()
             }
 
@@ -416,51 +407,13 @@ Item {
                 onClicked: gameGraph.visible = !gameGraph.visible
             }
 
-            Canvas {
+            // Linien werden im Scene-Graph gebaut und bei neuen Zeilen nur ergänzt
+            HandCountChart {
                 id: gameGraph
                 width: parent.width - 32
                 height: 220
-                visible: graphData.length > 0
-                onVisibleChanged: if (visible) requestPaint()
-                onPaint: {
-                    var ctx = getContext("2d")
-                    ctx.clearRect(0, 0, width, height)
-                    if (graphData.length === 0) return
-
-                    var seriesCount = graphData[0].length
-                    var pointsCount = graphData.length
-                    var maxVal = 1
-                    for (var i = 0; i < graphData.length; i++) {
-                        for (var j = 0; j < graphData[i].length; j++) {
-                            maxVal = Math.max(maxVal, graphData[i][j])
-                        }
-                    }
-
-                    var colors = ["#e74c3c", "#3498db", "#2ecc71", "#f1c40f", "#9b59b6", "#e67e22"]
-                    var padding = 20
-                    var plotW = width - padding * 2
-                    var plotH = height - padding * 2
-
-                    ctx.strokeStyle = "#000000"
-                    ctx.beginPath()
-                    ctx.moveTo(padding, padding)
-                    ctx.lineTo(padding, padding + plotH)
-                    ctx.lineTo(padding + plotW, padding + plotH)
-                    ctx.stroke()
-
-                    for (var p = 0; p < seriesCount; p++) {
-                        ctx.strokeStyle = colors[p % colors.length]
-                        ctx.beginPath()
-                        for (var x = 0; x < pointsCount; x++) {
-                            var value = graphData[x][p]
-                            var px = padding + (pointsCount === 1 ? 0 : (x / (pointsCount - 1)) * plotW)
-                            var py = padding + plotH - (value / maxVal) * plotH
-                            if (x === 0) ctx.moveTo(px, py)
-                            else ctx.lineTo(px, py)
-                        }
-                        ctx.stroke()
-                    }
-                }
+                model: gameClient.history
+                visible: gameClient.history.count > 0
             }
         }
     }
@@ -483,45 +436,6 @@ Item {
         return gameClient.currentPlayerIndex
     }
 
-    //Parsed die Karten die übergeben werden
-    function parseCard(cardId) {
-        var base = normalizeCardName(cardId)
-        var dot = base.lastIndexOf(".")
-        if (dot >= 0) {
-            base = base.slice(0, dot)
-        }
-        var parts = base.split("_")
-        if (parts.length === 0) {
-            return { color: "", value: "", wild: false }
-        }
-        if (parts[0] === "Extra") {
-            return { color: "Extra", value: parts.slice(1).join("_"), wild: true }
-        }
-        return { color: parts[0], value: parts.slice(1).join("_"), wild: false }
-    }
-
-    //Prüft ob die Karte gelegt werden darf (Farbe, Nummer, Extra)
-    function isLegalCard(cardId) {
-        if (!lastDiscardId || lastDiscardId.length === 0) {
-            return true
-        }
-        var playInfo = parseCard(cardId)
-        if (playInfo.wild) {
-            return true
-        }
-        var topInfo = parseCard(lastDiscardId)
-        if (topInfo.wild) {
-            return gameClient.currentColor && playInfo.color === gameClient.currentColor
-        }
-        return playInfo.color === topInfo.color || playInfo.value === topInfo.value
-    }
-
-    //Schaut ob es eine Extra Karte oder normale Karte ist, da bei Extra Karten keine Farbe benötigt wird.
-    function requiresColor(cardId) {
-        var info = parseCard(cardId)
-        return info.wild
-    }
-
     //Lässt den Nutzer die Farbe auswählen, wenn er eine Extra Karte mit Farbwechsel legt
     function chooseColor(colorName) {
         if (pendingWildCard.length === 0) {
@@ -532,77 +446,4 @@ Item {
         pendingWildCard = ""
         colorPicker.close()
     }
-
-    //Erstellt den Graphen der CSV am Ende des Spiels, um zu sehen welcher Spielen wann wie viele Karten hatte.
-    function buildGraphData(logCsv, playerCount) {
-        if (!logCsv || logCsv.length === 0 || playerCount === 0) {
-            return []
-        }
-        var lines = logCsv.split("\n")
-        var headerSkipped = false
-        var counts = []
-        var series = []
-
-        function parseLine(line) {
-            var first = line.indexOf(",")
-            if (first < 0) return null
-            var second = line.indexOf(",", first + 1)
-            if (second < 0) return null
-            var third = line.indexOf(",", second + 1)
-            if (third < 0) return null
-            return {
-                event: line.slice(first + 1, second),
-                playerIndex: parseInt(line.slice(second + 1, third)),
-                detail: line.slice(third + 1)
-            }
-        }
-
-        for (var i = 0; i < lines.length; i++) {
-            var line = lines[i].trim()
-            if (line.length === 0) continue
-            if (!headerSkipped) {
-                headerSkipped = true
-                continue
-            }
-            var parsed = parseLine(line)
-            if (!parsed) continue
-            if (parsed.event === "start") {
-                var handsIndex = parsed.detail.indexOf("hands=")
-                if (handsIndex >= 0) {
-                    var handsPart = parsed.detail.slice(handsIndex + 6)
-                    var comma = handsPart.indexOf(",")
-                    if (comma >= 0) handsPart = handsPart.slice(0, comma)
-                    var parts = handsPart.split("|")
-                    counts = []
-                    for (var p = 0; p < playerCount; p++) {
-                        counts.push(parseInt(parts[p] || "0"))
-                    }
-                    series.push(counts.slice())
-                }
-                continue
-            }
-
-            if (counts.length === 0) {
-                counts = Array(playerCount).fill(0)
-            }
-
-            if (parsed.event === "play") {
-                if (parsed.playerIndex >= 0 && parsed.playerIndex < playerCount) {
-                    counts[parsed.playerIndex] = Math.max(0, counts[parsed.playerIndex] - 1)
-                }
-            } else if (parsed.event === "draw" || parsed.event === "draw_four" || parsed.event === "uno_penalty") {
-                if (parsed.playerIndex >= 0 && parsed.playerIndex < playerCount) {
-                    var drawAmount = 0
-                    var match = parsed.detail.match(/drawn=(\d+)/)
-                    if (match) drawAmount = parseInt(match[1])
-                    if (!drawAmount && parsed.event === "draw") drawAmount = parseInt(parsed.detail)
-                    counts[parsed.playerIndex] += drawAmount
-                }
-            }
-
-            series.push(counts.slice())
-        }
-
-        return series
-    }
 }
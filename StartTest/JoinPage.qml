@@ -8,6 +8,7 @@ Item {
     property string serverHost: "127.0.0.1"
     property int serverPort: 12345
     property string _pendingJoinCode: ""
+    property bool _pendingSpectate: false
     // Code aus dem TextField (Main.qml greift darauf zu)
     property string gameCode: ""
 
@@ -22,7 +23,12 @@ Item {
             if (gameClient.connected && root._pendingJoinCode.length > 0) {
                 const c = root._pendingJoinCode
                 root._pendingJoinCode = ""
-                gameClient.joinGame(c)
+                if (root._pendingSpectate) {
+                    root._pendingSpectate = false
+                    gameClient.spectateGame(c)
+                } else {
+                    gameClient.joinGame(c)
+                }
             }
         }
     }
@@ -132,6 +138,7 @@ Item {
                 // Wenn nicht verbunden: verbinden und JOIN vormerken
                 if (!gameClient.connected) {
                     root._pendingJoinCode = code
+                    root._pendingSpectate = false
                     gameClient.connectToServer(root.serverHost, root.serverPort)
                     return
                 }
@@ -140,5 +147,35 @@ Item {
             }
 
         }
+
+        //Button um dem Spiel nur zuzuschauen (ohne eigene Karten)
+        Button {
+            id: spectateBtn
+            text: "Zuschauen"
+            width: 220
+            height: 44
+            x: (form.width - width)/2
+            y: 244
+            font.pixelSize: 18
+
+            background: Rectangle { color: "white"; border.width: 2; border.color: "black" }
+
+            enabled: codeField.text.trim().length > 0
+            opacity: enabled ? 1.0 : 0.65
+
+            onClicked: {
+                const code = root.gameCode.trim()
+                if (code.length === 0) return
+
+                if (!gameClient.connected) {
+                    root._pendingJoinCode = code
+                    root._pendingSpectate = true
+                    gameClient.connectToServer(root.serverHost, root.serverPort)
+                    return
+                }
+
+                gameClient.spectateGame(code)
+            }
+        }
     }
 }
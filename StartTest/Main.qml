@@ -11,6 +11,8 @@ Window {
 
     property string serverHost: "127.0.0.1"
     property int serverPort: 12345
+    property bool _pendingQueue: false
+    property bool showNetStats: false
 
     //Start Fenster mit der "Spiel hosten" oder "Mit Code beitreten" auswahl
     StackView {
@@ -21,6 +23,14 @@ Window {
             anchors.fill: parent
             onHostGame: stack.push(startPageComponent)
             onJoinWithCode: stack.push(joinPageComponent)
+            onQuickMatch: {
+                if (!gameClient.connected) {
+                    win._pendingQueue = true
+                    gameClient.connectToServer(win.serverHost, win.serverPort)
+                    return
+                }
+                gameClient.queueJoin(2)
+            }
         }
     }
 
@@ -71,6 +81,15 @@ Window {
 
         //function onGameCreated(code) { toast.show("Spiel erstellt: " + code) }
         function onJoinOk(code) { toast.show("Beitritt OK: " + code) }
+        function onQueued(tableSize) { toast.show("Suche Mitspieler (" + tableSize + " Spieler)...") }
+        function onMatchFound(code) { toast.show("Spiel gefunden: " + code) }
+
+        function onConnectedChanged() {
+            if (gameClient.connected && win._pendingQueue) {
+                win._pendingQueue = false
+                gameClient.queueJoin(2)
+            }
+        }
 
         function onGameStateChanged() {
             if (gameClient.hasGameInit) {
@@ -86,6 +105,44 @@ Window {
         function onError(message) { toast.show(message) }
     }
 
+    //Debug-Anzeige der Verbindung (F3): RTT vom Server gemessen, Zuglatenz vom Client
+    Shortcut {
+        sequence: "F3"
+        context: Qt.ApplicationShortcut
+        onActivated: win.showNetStats = !win.showNetStats
+    }
+
+    Rectangle {
+        id: netStats
+        visible: win.showNetStats
+        z: 100
+        anchors.top: parent.top
+        anchors.right: parent.right
+        anchors.margins: 8
+        width: netStatsText.implicitWidth + 16
+        height: netStatsText.implicitHeight + 12
+        color: "#b0000000"
+        radius: 4
+
+        function ms(v) { return v < 0 ? "-" : v.toFixed(1) + " ms" }
+
+        Text {
+            id: netStatsText
+            anchors.centerIn: parent
+            color: "white"
+            font.family: "monospace"
+            font.pixelSize: 12
+            property var s: gameClient.connectionStats
+            text: !gameClient.connected ? "nicht verbunden"
+                  : !s.valid ? "warte auf ping..."
+                  : "RTT      " + netStats.ms(s.rttMs) + " (geglättet " + netStats.ms(s.smoothedRttMs) + ")\n"
+                    + "p50/p95/p99 " + netStats.ms(s.rttP50Ms) + " / " + netStats.ms(s.rttP95Ms) + " / " + netStats.ms(s.rttP99Ms) + "\n"
+                    + "Uhr      " + (s.clockOffsetMs >= 0 ? "+" : "") + s.clockOffsetMs.toFixed(0) + " ms, " + s.samples + " Messungen\n"
+                    + "Server   p95 " + netStats.ms(s.processingP95Ms) + " pro Nachricht\n"
+                    + "Zug      " + netStats.ms(s.moveLatencyMs) + " bis card_played"
+        }
+    }
+
     //Zeigt die ganzen Toasts an, z.B "Beitritt Ok..."
     Popup {
         id: toast
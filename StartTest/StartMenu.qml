@@ -8,6 +8,7 @@ Item {
 
     signal hostGame()
     signal joinWithCode()
+    signal quickMatch()
 
     // Hintergrund füllt immer das ganze Fenster
     Rectangle {
@@ -58,5 +59,22 @@ Item {
             //Spielbeitritts Fenster wird geöffnet
             onClicked: root.joinWithCode()
         }
+
+        //Button für ein automatisch zusammengestelltes Spiel (Warteschlange auf dem Server)
+        Button {
+            id: quickBtn
+            text: "Schnelles Spiel"
+            width: 260
+            height: 50
+            font.pixelSize: 18
+            anchors.horizontalCenter: parent.horizontalCenter
+
+            background: Rectangle {
+                color: "white"
+                border.color: "black"
+                border.width: 2
+            }
+            onClicked: root.quickMatch()
+        }
     }
 }
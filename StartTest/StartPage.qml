@@ -93,6 +93,43 @@ Item {
         }
     }
 
+    //Fügt dem erstellten Spiel vor dem Start einen Server-Bot hinzu
+    Button {
+        id: botBtn
+        text: "Bot hinzufügen"
+        width: 230
+        height: 72
+        anchors.left: parent.left
+        anchors.leftMargin: 120
+        anchors.top: copyBtn.bottom
+        anchors.topMargin: 20
+        font.pixelSize: 20
+        enabled: root.hostCode.trim().length > 0 && gameClient.connected
+        opacity: enabled ? 1.0 : 0.65
+
+        background: Rectangle { color: "#ffd08f"; border.color: "black"; border.width: 2 }
+
+        onClicked: gameClient.addBot(root.hostCode.trim())
+    }
+
+    //Fügt einen starken Bot hinzu (Server rechnet per Baumsuche)
+    Button {
+        id: strongBotBtn
+        text: "Starker Bot"
+        width: 230
+        height: 72
+        anchors.left: botBtn.right
+        anchors.leftMargin: 20
+        anchors.top: botBtn.top
+        font.pixelSize: 20
+        enabled: botBtn.enabled
+        opacity: enabled ? 1.0 : 0.65
+
+        background: Rectangle { color: "#ffb35c"; border.color: "black"; border.width: 2 }
+
+        onClicked: gameClient.addBot(root.hostCode.trim(), true)
+    }
+
     //Button um zur Skinauswahl zu kommen
     Button {
         id: skinsBtn
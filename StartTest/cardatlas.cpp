@@ -0,0 +1,104 @@
+#include "cardatlas.h"
+#include "cardcatalog.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QPainter>
+#include <QList>
+#include <QStringList>
+
+//Lädt alle Kartenbilder aus den Ressourcen und packt sie zeilenweise in ein Raster
+void CardAtlas::build()
+{
+    m_rects.clear();
+    m_image = QImage();
+    m_cellSize = QSize();
+
+    // Feste Liste statt Verzeichnis durchsuchen: Karten in Katalog-Reihenfolge, Rückseite zuletzt
+    QStringList files;
+    files.reserve(CardCatalog::CardCount + 1);
+    for (int i = 0; i < CardCatalog::CardCount; ++i)
+        files.append(QString(CardCatalog::resource(i)));
+    if (CardCatalog::BackResource[0] != '\0')
+        files.append(QString::fromLatin1(CardCatalog::BackResource));
+
+    struct Entry {
+        QString id;
+        QImage image;
+    };
+    QList<Entry> entries;
+    entries.reserve(files.size());
+
+    for (const QString& file : files) {
+        const QString id = normalizeId(file);
+        if (m_rects.contains(id))
+            continue;   // doppelte ID: die erste gewinnt
+        QImageReader reader(file);
+        QImage img = reader.read();
+        if (img.isNull()) {
+            qWarning() << "CardAtlas: cannot read" << file << reader.errorString();
+            continue;
+        }
+        m_cellSize = m_cellSize.expandedTo(img.size());
+        m_rects.insert(id, QRect());
+        entries.append({ id, img });
+    }
+    if (entries.isEmpty())
+        return;
+
+    const int rows = (int(entries.size()) + Columns - 1) / Columns;
+    m_image = QImage(m_cellSize.width() * Columns, m_cellSize.height() * rows,
+                     QImage::Format_ARGB32_Premultiplied);
+    m_image.fill(Qt::transparent);
+
+    QPainter p(&m_image);
+    p.setRenderHint(QPainter::SmoothPixmapTransform);
+    for (int i = 0; i < entries.size(); ++i) {
+        const Entry& e = entries.at(i);
+        QImage img = e.image;
+        if (img.width() > m_cellSize.width() || img.height() > m_cellSize.height())
+            img = img.scaled(m_cellSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        const QPoint origin((i % Columns) * m_cellSize.width(), (i / Columns) * m_cellSize.height());
+        p.drawImage(origin, img);
+        m_rects.insert(e.id, QRect(origin, img.size()));
+    }
+    p.end();
+
+    qInfo() << "CardAtlas:" << entries.size() << "cards," << m_image.size();
+}
+
+QString CardAtlas::normalizeId(const QString& cardId)
+{
+    QString id = cardId.trimmed();
+    const int slash = id.lastIndexOf('/');
+    if (slash >= 0)
+        id = id.mid(slash + 1);
+    const QString suffix = QFileInfo(id).suffix().toLower();
+    if (suffix == "jpg" || suffix == "jpeg" || suffix == "png")
+        id.chop(suffix.size() + 1);
+    id.replace(' ', '_');
+    while (id.contains("__"))
+        id.replace("__", "_");
+    return id;
+}
+
+//Schneidet eine Karte aus dem Atlas, optional auf sourceSize skaliert
+QImage CardAtlas::card(const QString& cardId, const QSize& requestedSize) const
+{
+    const QRect rect = rectFor(cardId);
+    if (rect.isNull())
+        return QImage();
+
+    QImage card = m_image.copy(rect);
+
+    // sourceSize darf auch nur eine Seite vorgeben
+    QSize target = requestedSize;
+    if (target.width() <= 0 && target.height() > 0)
+        target.setWidth(rect.width() * target.height() / rect.height());
+    else if (target.height() <= 0 && target.width() > 0)
+        target.setHeight(rect.height() * target.width() / rect.width());
+    if (target.isValid() && !target.isEmpty() && target != rect.size())
+        card = card.scaled(target, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    return card;
+}
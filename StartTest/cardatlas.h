@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QRect>
+#include <QString>
+
+// Alle Kartenbilder (Vorderseiten + Gegnerkarte) einmal laden und in ein
+// gemeinsames Bild packen. Einzelne Karten sind danach nur noch Ausschnitte daraus.
+// Welche Bilder es gibt, steht in der beim Build erzeugten Tabelle (CardCatalog::Cards).
+class CardAtlas
+{
+public:
+    static constexpr int Columns = 8;
+
+    void build();
+
+    bool isEmpty() const { return m_rects.isEmpty(); }
+    bool contains(const QString& cardId) const { return m_rects.contains(normalizeId(cardId)); }
+    QRect rectFor(const QString& cardId) const { return m_rects.value(normalizeId(cardId)); }
+    QSize cellSize() const { return m_cellSize; }
+    const QImage& image() const { return m_image; }
+
+    // Ausschnitt einer Karte, auf requestedSize skaliert (leeres Bild, wenn unbekannt)
+    QImage card(const QString& cardId, const QSize& requestedSize = QSize()) const;
+
+    // "Blau 2", "Blau_2.jpg", "Blau_2.png" -> "Blau_2"
+    static QString normalizeId(const QString& cardId);
+
+private:
+    QImage m_image;
+    QSize m_cellSize;
+    QHash<QString, QRect> m_rects;
+};
@@ -0,0 +1,135 @@
+#include "cardimageprovider.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+CardImageStore::CardImageStore(const QString& diskCacheDir)
+    : m_memory(MemoryCacheKb)
+{
+    if (!diskCacheDir.isEmpty()) {
+        m_diskDir = QDir(diskCacheDir).filePath(QString("cards-v%1").arg(DiskCacheVersion));
+        if (!QDir().mkpath(m_diskDir)) {
+            qWarning() << "CardImageStore: disk cache disabled, cannot create" << m_diskDir;
+            m_diskDir.clear();
+        }
+    }
+}
+
+//Speicher -> Platte -> Atlas; jede neu skalierte Variante wird in beiden Caches abgelegt
+QImage CardImageStore::card(const QString& id, const QSize& requestedSize)
+{
+    const QString cardId = CardAtlas::normalizeId(id);
+    const QString key = QString("%1_%2x%3").arg(cardId).arg(requestedSize.width()).arg(requestedSize.height());
+
+    {
+        QMutexLocker lock(&m_cacheMutex);
+        if (const QImage* hit = m_memory.object(key))
+            return *hit;
+    }
+
+    QImage img;
+    const QString path = diskPath(key);
+    if (!path.isEmpty() && QFile::exists(path))
+        img.load(path, "PNG");
+
+    if (img.isNull()) {
+        img = scaledFromAtlas(cardId, requestedSize);
+        if (img.isNull())
+            return img;
+        if (!path.isEmpty()) {
+            QSaveFile out(path);
+            if (out.open(QIODevice::WriteOnly) && img.save(&out, "PNG"))
+                out.commit();
+        }
+    }
+
+    QMutexLocker lock(&m_cacheMutex);
+    m_memory.insert(key, new QImage(img), qMax<qsizetype>(1, img.sizeInBytes() / 1024));
+    return img;
+}
+
+//Baut den Atlas beim ersten Cache-Fehlschlag; danach wird er nur noch gelesen
+QImage CardImageStore::scaledFromAtlas(const QString& id, const QSize& target)
+{
+    QMutexLocker lock(&m_atlasMutex);
+    if (!m_atlasBuilt) {
+        m_atlas.build();
+        m_atlasBuilt = true;
+    }
+    lock.unlock();
+    return m_atlas.card(id, target);
+}
+
+QString CardImageStore::diskPath(const QString& key) const
+{
+    if (m_diskDir.isEmpty())
+        return QString();
+    return m_diskDir + '/' + key + ".png";
+}
+
+CardImageRunnable::CardImageRunnable(std::shared_ptr<CardImageStore> store, const QString& id, const QSize& requestedSize)
+    : m_store(std::move(store)), m_id(id), m_requestedSize(requestedSize)
+{
+    setAutoDelete(false);
+}
+
+void CardImageRunnable::run()
+{
+    // Seite schon verlassen: nicht mehr dekodieren
+    if (m_cancelled.loadAcquire()) {
+        emit done(QImage());
+    } else {
+        emit done(m_store->card(m_id, m_requestedSize));
+    }
+    deleteLater();
+}
+
+CardImageResponse::CardImageResponse(std::shared_ptr<CardImageStore> store, const QString& id,
+                                     const QSize& requestedSize, QThreadPool* pool)
+    : m_id(id)
+{
+    m_runnable = new CardImageRunnable(std::move(store), id, requestedSize);
+    connect(m_runnable, &CardImageRunnable::done, this, &CardImageResponse::handleDone);
+    pool->start(m_runnable);
+}
+
+void CardImageResponse::handleDone(QImage image)
+{
+    m_runnable = nullptr;
+    m_image = image;
+    if (m_image.isNull())
+        m_error = QString("Unknown card: %1").arg(m_id);
+    emit finished();
+}
+
+QQuickTextureFactory* CardImageResponse::textureFactory() const
+{
+    return QQuickTextureFactory::textureFactoryForImage(m_image);
+}
+
+void CardImageResponse::cancel()
+{
+    if (m_runnable)
+        m_runnable->cancel();
+}
+
+CardImageProvider::CardImageProvider(const QString& diskCacheDir)
+    : m_store(std::make_shared<CardImageStore>(diskCacheDir))
+{
+    // Zwei Worker reichen: die Bilder sind klein, mehr würde nur mit dem GUI-Thread konkurrieren
+    m_pool.setMaxThreadCount(2);
+    m_pool.setObjectName("CardImagePool");
+}
+
+CardImageProvider::~CardImageProvider()
+{
+    m_pool.waitForDone();
+}
+
+QQuickImageResponse* CardImageProvider::requestImageResponse(const QString& id, const QSize& requestedSize)
+{
+    return new CardImageResponse(m_store, id, requestedSize, &m_pool);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QAtomicInteger>
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QQuickAsyncImageProvider>
+#include <QRunnable>
+#include <QThreadPool>
+#include <memory>
+
+#include "cardatlas.h"
+
+// Gemeinsamer Stand für alle Worker: Atlas (erst bei Bedarf gebaut), fertig skalierte
+// Varianten im Speicher und optional auf der Platte. Wird über shared_ptr gehalten,
+// damit laufende Jobs den Provider überleben dürfen.
+class CardImageStore
+{
+public:
+    static constexpr int MemoryCacheKb = 8 * 1024;
+    static constexpr int DiskCacheVersion = 1;
+
+    explicit CardImageStore(const QString& diskCacheDir);
+
+    // requestedSize ist schon mit dem devicePixelRatio multipliziert (macht QQuickImage für image://)
+    QImage card(const QString& id, const QSize& requestedSize);
+
+private:
+    QImage scaledFromAtlas(const QString& id, const QSize& target);
+    QString diskPath(const QString& key) const;
+
+    QMutex m_atlasMutex;
+    bool m_atlasBuilt = false;
+    CardAtlas m_atlas;
+
+    QMutex m_cacheMutex;
+    QCache<QString, QImage> m_memory;
+    QString m_diskDir;
+};
+
+// Ein Job im Pool: holt die Karte aus dem Store und meldet sich über done()
+class CardImageRunnable : public QObject, public QRunnable
+{
+    Q_OBJECT
+
+public:
+    CardImageRunnable(std::shared_ptr<CardImageStore> store, const QString& id, const QSize& requestedSize);
+
+    void run() override;
+    void cancel() { m_cancelled.storeRelease(1); }
+
+signals:
+    void done(QImage image);
+
+private:
+    std::shared_ptr<CardImageStore> m_store;
+    QString m_id;
+    QSize m_requestedSize;
+    QAtomicInteger<int> m_cancelled = 0;
+};
+
+class CardImageResponse : public QQuickImageResponse
+{
+    Q_OBJECT
+
+public:
+    CardImageResponse(std::shared_ptr<CardImageStore> store, const QString& id,
+                      const QSize& requestedSize, QThreadPool* pool);
+
+    QQuickTextureFactory* textureFactory() const override;
+    QString errorString() const override { return m_error; }
+    void cancel() override;
+
+private:
+    void handleDone(QImage image);
+
+    CardImageRunnable* m_runnable = nullptr;
+    QString m_id;
+    QImage m_image;
+    QString m_error;
+};
+
+// image://cards/<id> – dekodiert und skaliert im Worker-Pool statt im GUI-Thread
+class CardImageProvider : public QQuickAsyncImageProvider
+{
+public:
+    explicit CardImageProvider(const QString& diskCacheDir = QString());
+    ~CardImageProvider() override;
+
+    QQuickImageResponse* requestImageResponse(const QString& id, const QSize& requestedSize) override;
+
+private:
+    QThreadPool m_pool;
+    std::shared_ptr<CardImageStore> m_store;
+};
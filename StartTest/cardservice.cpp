@@ -1,6 +1,6 @@
 #include "cardservice.h"
+#include "cardcatalog.h"
 
-#include <QDir>
 #include <QUrl>
 #include <QRandomGenerator>
 #include <algorithm>
@@ -24,18 +24,10 @@ void CardService::loadAllCardsFromResources()
 {
     m_allCards.clear();
 
-    // Ressourcen-Pfad (durch qt_add_resources PREFIX "/" => ":/assets/...")
-    QDir dir(":/assets/images/cards");
-    if (!dir.exists())
-        return;
-
-    const QStringList filters = { "*.png", "*.jpg", "*.jpeg" };
-    const QStringList files = dir.entryList(filters, QDir::Files | QDir::Readable, QDir::Name);
-
-    for (const QString &file : files) {
-        const QString fullQrcPath = dir.absoluteFilePath(file); // ":/assets/images/cards/..."
-        m_allCards.append(toQrcUrl(fullQrcPath));
-    }
+    // Kartenliste kommt aus der beim Build erzeugten Tabelle, kein Durchsuchen der Ressourcen
+    m_allCards.reserve(CardCatalog::CardCount);
+    for (int i = 0; i < CardCatalog::CardCount; ++i)
+        m_allCards.append(toQrcUrl(QString(CardCatalog::resource(i))));
 }
 
 void CardService::shuffleDeck()
@@ -0,0 +1,9 @@
+#include "connectionstats.h"
+
+ConnectionStats::ConnectionStats(QObject* parent) : QObject(parent) {}
+
+void ConnectionStats::update(const LatencyStats& stats)
+{
+    m_stats = stats;
+    emit changed();
+}
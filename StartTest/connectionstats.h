@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QObject>
+#include <QtQml/qqmlregistration.h>
+
+#include "clientcore.h"
+
+// Latenzwerte für die Debug-Anzeige. RTT, Uhrenabweichung und Perzentile misst der Server
+// per ping/pong und schickt sie als "latency"; moveLatencyMs misst der Client selbst
+// (play_card gesendet -> card_played empfangen). Die Differenz zur RTT ist ungefähr
+// die Zeit, die der Zug im Server verbracht hat.
+class ConnectionStats : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("Kommt aus gameClient.connectionStats")
+    Q_PROPERTY(bool valid READ valid NOTIFY changed)
+    Q_PROPERTY(double rttMs READ rttMs NOTIFY changed)
+    Q_PROPERTY(double smoothedRttMs READ smoothedRttMs NOTIFY changed)
+    Q_PROPERTY(double clockOffsetMs READ clockOffsetMs NOTIFY changed)
+    Q_PROPERTY(int samples READ samples NOTIFY changed)
+    Q_PROPERTY(double rttP50Ms READ rttP50Ms NOTIFY changed)
+    Q_PROPERTY(double rttP95Ms READ rttP95Ms NOTIFY changed)
+    Q_PROPERTY(double rttP99Ms READ rttP99Ms NOTIFY changed)
+    Q_PROPERTY(double processingP95Ms READ processingP95Ms NOTIFY changed)
+    Q_PROPERTY(double moveLatencyMs READ moveLatencyMs NOTIFY changed)
+
+public:
+    explicit ConnectionStats(QObject* parent = nullptr);
+
+    bool valid() const { return m_stats.samples > 0; }
+    double rttMs() const { return m_stats.rttMs; }
+    double smoothedRttMs() const { return m_stats.smoothedRttMs; }
+    double clockOffsetMs() const { return m_stats.clockOffsetMs; }
+    int samples() const { return m_stats.samples; }
+    double rttP50Ms() const { return m_stats.rttP50Ms; }
+    double rttP95Ms() const { return m_stats.rttP95Ms; }
+    double rttP99Ms() const { return m_stats.rttP99Ms; }
+    double processingP95Ms() const { return m_stats.processingP95Ms; }
+    double moveLatencyMs() const { return m_stats.moveLatencyMs; }
+
+    // Stand aus ClientCore übernehmen (bei LatencyChanged)
+    void update(const LatencyStats& stats);
+
+signals:
+    void changed();
+
+private:
+    LatencyStats m_stats;
+};
@@ -1,209 +1,284 @@
 #include "gameclient.h"
 
+#include <QDateTime>
 #include <QJsonDocument>
-#include <QJsonArray>
 #include <QDebug>
-#include <QFile>
-#include <QTextStream>
 #include <QUrl>
 
-GameClient::GameClient(QObject* parent) : QObject(parent)
+GameClient::GameClient(QObject* parent)
+    : QObject(parent), m_events(NetworkWorker::QueueCapacity), m_core(coreCallbacks()), m_hand(&m_core.hand())
 {
-    connect(&m_sock, &QTcpSocket::connected, this, [this]() {
-        m_connected = true;
-        emit connectedChanged();
-        emit info("Verbunden.");
+    // Socket und JSON-Parsing laufen im Netzwerk-Thread, hier wird nur noch angewendet
+    m_worker = new NetworkWorker(&m_events);
+    m_worker->moveToThread(&m_netThread);
+    connect(&m_netThread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(m_worker, &NetworkWorker::eventsAvailable, this, &GameClient::scheduleDrain);
+    m_netThread.setObjectName("GameClientNetwork");
+    m_netThread.start();
+
+    m_frameTimer.setSingleShot(true);
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_frameTimer, &QTimer::timeout, this, &GameClient::drainEvents);
+    m_frameClock.start();
+
+    m_reconnectTimer.setSingleShot(true);
+    connect(&m_reconnectTimer, &QTimer::timeout, this, &GameClient::openConnection);
+
+    m_pendingTimer.setSingleShot(true);
+    connect(&m_pendingTimer, &QTimer::timeout, this, [this]() {
+        m_core.expirePredictions(QDateTime::currentMSecsSinceEpoch());
+        flushChanges();
     });
+}
+
+GameClient::~GameClient()
+{
+    m_netThread.requestInterruption();
+    m_netThread.quit();
+    m_netThread.wait();
+}
 
-    connect(&m_sock, &QTcpSocket::disconnected, this, [this]() {
+//Verbindet ClientCore mit Signalen, Modellen und dem Netzwerk-Thread
+ClientCore::Callbacks GameClient::coreCallbacks()
+{
+    ClientCore::Callbacks cb;
+    cb.send = [this](const QJsonObject& o) { sendJson(o); };
+    cb.info = [this](const QString& msg) { emit info(msg); };
+    cb.error = [this](const QString& msg) { emit error(msg); };
+    cb.lobby = [this](ServerMessage message, const QJsonObject& o) {
+        switch (message) {
+        case ServerMessage::GameCreated: emit gameCreated(o.value("code").toString()); break;
+        case ServerMessage::JoinOk: emit joinOk(o.value("code").toString()); break;
+        case ServerMessage::QueueOk: emit queued(o.value("size").toInt()); break;
+        case ServerMessage::MatchFound: emit matchFound(o.value("code").toString()); break;
+        default: break;
+        }
+    };
+    cb.redirect = [this](const QString& host, int port) {
+        if (!host.isEmpty())
+            m_host = host;
+        if (port > 0)
+            m_port = port;
         m_connected = false;
         emit connectedChanged();
-        emit info("Getrennt.");
-    });
-
-    connect(&m_sock, &QTcpSocket::errorOccurred, this, [this](QAbstractSocket::SocketError) {
-        emit error(m_sock.errorString());
-    });
-
-    connect(&m_sock, &QTcpSocket::readyRead, this, [this]() {
-        m_buffer += m_sock.readAll();
-
-        while (true) {
-            const int nl = m_buffer.indexOf('\n');
-            if (nl < 0) break;
-
-            const QByteArray line = m_buffer.left(nl).trimmed();
-            m_buffer.remove(0, nl + 1);
-            if (line.isEmpty()) continue;
-
-            QJsonParseError err;
-            const QJsonDocument doc = QJsonDocument::fromJson(line, &err);
-            if (err.error != QJsonParseError::NoError || !doc.isObject()) {
-                emit error("Server: invalid JSON");
-                continue;
-            }
-
-            const QJsonObject o = doc.object();
-            const QString type = o.value("type").toString();
+        // Neue Verbindungsnummer: restliche Events der alten Verbindung werden verworfen
+        openConnection();
+    };
+    cb.historyReset = [this](int players) { m_history.reset(players); };
+    cb.historyAppend = [this](const QList<int>& counts) { m_history.appendCounts(counts); };
+    return cb;
+}
 
-            if (type == "error") {
-                emit error(o.value("message").toString());
-                continue;
-            }
+QVariantList GameClient::handCounts() const
+{
+    QVariantList out;
+    out.reserve(state().handCounts.size());
+    for (int c : state().handCounts) out << c;
+    return out;
+}
 
-            if (type == "game_created") {
-                emit gameCreated(o.value("code").toString());
-                continue;
-            }
+//Startet eine neue Verbindung im Netzwerk-Thread; Events älterer Verbindungen zählen ab jetzt nicht mehr
+void GameClient::openConnection()
+{
+    ++m_generation;
+    m_socketActive = true;
+    const QString host = m_host;
+    const quint16 port = quint16(m_port);
+    const quint32 generation = m_generation;
+    QMetaObject::invokeMethod(m_worker, [w = m_worker, host, port, generation]() {
+        w->connectToHost(host, port, generation);
+    }, Qt::QueuedConnection);
+}
 
-            if (type == "join_ok") {
-                emit joinOk(o.value("code").toString());
-                continue;
-            }
+//Events höchstens einmal pro Frame anwenden, auch wenn der Server in Schüben sendet
+void GameClient::scheduleDrain()
+{
+    if (m_frameTimer.isActive())
+        return;
+    m_frameTimer.start(int(qMax<qint64>(0, FrameIntervalMs - m_frameClock.elapsed())));
+}
 
-            if (type == "game_init") {
-                m_hasGameInit = true;
-                m_gameCode = o.value("code").toString();
-                m_discardTop = o.value("discardTop").toString();
-                m_drawCount = o.value("drawCount").toInt();
-                m_players = o.value("players").toInt();
-                m_yourIndex = o.value("yourIndex").toInt();
-                m_currentPlayerIndex = o.value("currentPlayerIndex").toInt();
-                m_currentColor = o.value("currentColor").toString();
-                m_finished = o.value("finished").toBool(false);
-                m_winnerIndex = -1;
-                m_gameLog.clear();
-
-                m_hand.clear();
-                const QJsonArray arr = o.value("hand").toArray();
-                for (const QJsonValue& v : arr) m_hand << v.toString();
-
-                m_handCounts.clear();
-                const QJsonArray countsArr = o.value("handCounts").toArray();
-                for (const QJsonValue& v : countsArr) m_handCounts << v.toInt();
-
-                emit gameStateChanged();
-                emit info(QString("game_init: hand=%1 discard=%2").arg(m_hand.size()).arg(m_discardTop));
-                continue;
+void GameClient::drainEvents()
+{
+    m_frameClock.restart();
+    m_worker->clearWake();
+
+    ServerEvent ev;
+    while (m_events.tryPop(ev)) {
+        if (ev.generation != m_generation)
+            continue;
+
+        switch (ev.kind) {
+        case ServerEvent::Kind::Connected:
+            onConnected();
+            break;
+        case ServerEvent::Kind::Disconnected:
+            onDisconnected();
+            break;
+        case ServerEvent::Kind::SocketError:
+            emit error(ev.errorText);
+            if (ev.unconnected) {
+                m_socketActive = false;
+                scheduleReconnect(m_core.onConnectFailed());
             }
+            break;
+        case ServerEvent::Kind::InvalidJson:
+            emit error("Server: invalid JSON");
+            break;
+        case ServerEvent::Kind::Message:
+            m_core.handleMessage(ev.message, ev.payload, ev.receivedMs);
+            break;
+        }
+    }
 
-            if (type == "cards_drawn") {
-                const QJsonArray arr = o.value("cards").toArray();
-                for (const QJsonValue& v : arr) m_hand << v.toString();
-                m_drawCount = o.value("drawCount").toInt();
-                m_currentPlayerIndex = o.value("currentPlayerIndex").toInt();
+    // Ein Schub Nachrichten -> ein Satz Signale
+    flushChanges();
 
-                emit gameStateChanged();
-                emit info(QString("cards_drawn: +%1").arg(arr.size()));
-                continue;
-            }
+    // Queue war voll: Netzwerk-Thread darf weiterlesen
+    if (m_worker->isStalled())
+        QMetaObject::invokeMethod(m_worker, &NetworkWorker::processPending, Qt::QueuedConnection);
+}
 
-            if (type == "state_update") {
-                m_discardTop = o.value("discardTop").toString();
-                m_drawCount = o.value("drawCount").toInt();
-                m_currentPlayerIndex = o.value("currentPlayerIndex").toInt();
-                m_currentColor = o.value("currentColor").toString();
-                m_finished = o.value("finished").toBool(false);
+//Meldet alle seit dem letzten Aufruf geänderten Properties, jede höchstens einmal
+void GameClient::flushChanges()
+{
+    // Frist der ältesten Vorhersage nachführen (neue Vorhersage, Bestätigung oder Rücknahme)
+    const qint64 deadline = m_core.nextDeadlineMs();
+    if (deadline < 0)
+        m_pendingTimer.stop();
+    else
+        m_pendingTimer.start(int(qMax<qint64>(0, deadline - QDateTime::currentMSecsSinceEpoch())));
+
+    const quint32 dirty = m_core.takeChanges();
+    if (!dirty)
+        return;
 
-                m_handCounts.clear();
-                const QJsonArray countsArr = o.value("handCounts").toArray();
-                for (const QJsonValue& v : countsArr) m_handCounts << v.toInt();
+    if (dirty & ClientCore::LatencyChanged) m_connectionStats.update(m_core.latency());
+    if (!(dirty & ~quint32(ClientCore::LatencyChanged)))
+        return;
 
-                emit gameStateChanged();
-                continue;
-            }
+    if (dirty & ClientCore::HasGameInitChanged) emit hasGameInitChanged();
+    if (dirty & ClientCore::GameCodeChanged) emit gameCodeChanged();
+    if (dirty & ClientCore::SpectatingChanged) emit spectatingChanged();
+    if (dirty & ClientCore::PlayersChanged) emit playersChanged();
+    if (dirty & ClientCore::YourIndexChanged) emit yourIndexChanged();
+    if (dirty & ClientCore::DiscardTopChanged) emit discardTopChanged();
+    if (dirty & ClientCore::CurrentColorChanged) emit currentColorChanged();
+    if (dirty & ClientCore::DrawCountChanged) emit drawCountChanged();
+    if (dirty & ClientCore::CurrentPlayerIndexChanged) emit currentPlayerIndexChanged();
+    if (dirty & ClientCore::HandCountsChanged) emit handCountsChanged();
+    if (dirty & ClientCore::GameLogChanged) emit gameLogChanged();
+    if (dirty & ClientCore::WinnerIndexChanged) emit winnerIndexChanged();
+    // finished zuletzt: Handler sehen Gewinner und Log schon
+    if (dirty & ClientCore::FinishedChanged) emit finishedChanged();
+    emit gameStateChanged();
+}
 
-            if (type == "card_played") {
-                const int playerIndex = o.value("playerIndex").toInt();
-                const QString card = o.value("card").toString();
-                if (playerIndex == m_yourIndex) {
-                    m_hand.removeOne(card);
-                    emit gameStateChanged();
-                }
-                continue;
-            }
+void GameClient::onConnected()
+{
+    m_connected = true;
+    emit connectedChanged();
+    emit info("Verbunden.");
+    m_core.onConnected();
+}
 
-            if (type == "game_finished") {
-                m_finished = true;
-                m_winnerIndex = o.value("winnerIndex").toInt(-1);
-                m_gameLog = o.value("logCsv").toString();
-                emit gameStateChanged();
-                continue;
-            }
+void GameClient::onDisconnected()
+{
+    m_socketActive = false;
+    m_connected = false;
+    emit connectedChanged();
+    emit info("Getrennt.");
 
-            emit info("Server msg: " + type);
-        }
-    });
+    scheduleReconnect(m_core.onDisconnected(m_userDisconnect));
+    m_userDisconnect = false;
 }
 
 void GameClient::connectToServer(const QString& host, int port)
 {
-    if (m_sock.state() == QAbstractSocket::ConnectedState ||
-        m_sock.state() == QAbstractSocket::ConnectingState) {
+    if (m_socketActive)
         return;
-    }
-    m_sock.connectToHost(host, quint16(port));
+    m_host = host;
+    m_port = port;
+    openConnection();
 }
 
 void GameClient::disconnectFromServer()
 {
-    m_sock.disconnectFromHost();
+    m_userDisconnect = true;
+    m_core.stopReconnecting();
+    m_reconnectTimer.stop();
+    QMetaObject::invokeMethod(m_worker, &NetworkWorker::disconnectFromHost, Qt::QueuedConnection);
+}
+
+//Plant den nächsten Reconnect-Versuch; die Pause kommt aus ClientCore (-1 = keiner)
+void GameClient::scheduleReconnect(int delayMs)
+{
+    if (delayMs < 0)
+        return;
+    m_reconnectTimer.start(delayMs);
 }
 
 void GameClient::sendJson(const QJsonObject& o)
 {
     const QByteArray payload = QJsonDocument(o).toJson(QJsonDocument::Compact) + "\n";
-    m_sock.write(payload);
-    m_sock.flush();
+    QMetaObject::invokeMethod(m_worker, [w = m_worker, payload]() { w->write(payload); }, Qt::QueuedConnection);
 }
 
 void GameClient::createGame()
 {
-    sendJson(QJsonObject{{"type","create_game"}});
+    m_core.createGame();
 }
 
 void GameClient::joinGame(const QString& code)
 {
-    sendJson(QJsonObject{{"type","join_game"},{"code",code.trimmed().toUpper()}});
+    m_core.joinGame(code);
 }
 
 void GameClient::startGame(const QString& code)
 {
-    sendJson(QJsonObject{{"type","start_game"},{"code",code.trimmed().toUpper()}});
+    m_core.startGame(code);
+}
+
+void GameClient::addBot(const QString& code, bool strong)
+{
+    m_core.addBot(code, strong);
+}
+
+void GameClient::spectateGame(const QString& code)
+{
+    m_core.spectateGame(code);
+}
+
+void GameClient::queueJoin(int tableSize)
+{
+    m_core.queueJoin(tableSize);
+}
+
+void GameClient::queueLeave()
+{
+    m_core.queueLeave();
 }
 
 void GameClient::drawCards(int count)
 {
-    if (count < 1) count = 1;
-    if (count > 10) count = 10;
-    sendJson(QJsonObject{{"type","draw_cards"},{"count",count}});
+    m_core.drawCards(count);
 }
 
 void GameClient::playCard(const QString& card, const QString& chosenColor)
 {
-    QJsonObject payload{{"type","play_card"},{"card",card}};
-    if (!chosenColor.isEmpty()) {
-        payload.insert("chosenColor", chosenColor);
-    }
-    sendJson(payload);
+    // Vorhergesagter Zug soll im selben Frame sichtbar sein, nicht erst beim nächsten drainEvents
+    m_core.playCard(card, chosenColor);
+    flushChanges();
 }
 
 void GameClient::declareUno()
 {
-    sendJson(QJsonObject{{"type","declare_uno"}});
+    m_core.declareUno();
 }
 
 bool GameClient::saveGameLog(const QString& fileUrl)
 {
+    // Schreiben läuft im Hintergrund, Ergebnis kommt über logExporter.finished
     const QString path = QUrl(fileUrl).toLocalFile();
-    if (path.isEmpty() || m_gameLog.isEmpty())
-        return false;
-
-    QFile file(path);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
-        return false;
-
-    QTextStream out(&file);
-    out << m_gameLog;
-    return true;
+    return m_logExporter.start(path, state().gameLog, LogExporter::formatForPath(path));
 }
@@ -1,10 +1,18 @@
 #pragma once
 
 #include <QObject>
-#include <QTcpSocket>
-#include <QStringList>
 #include <QJsonObject>
 #include <QVariantList>
+#include <QTimer>
+#include <QThread>
+#include <QElapsedTimer>
+
+#include "clientcore.h"
+#include "connectionstats.h"
+#include "gamehistorymodel.h"
+#include "handmodel.h"
+#include "logexporter.h"
+#include "networkworker.h"
 
 class GameClient : public QObject
 {
@@ -12,40 +20,51 @@ class GameClient : public QObject
     Q_PROPERTY(bool connected READ connected NOTIFY connectedChanged)
 
     // Game-State wird im Client gespeichert, damit GamePage ihn auch NACH game_init bekommt.
-    Q_PROPERTY(bool hasGameInit READ hasGameInit NOTIFY gameStateChanged)
-    Q_PROPERTY(QString gameCode READ gameCode NOTIFY gameStateChanged)
-    Q_PROPERTY(QStringList hand READ hand NOTIFY gameStateChanged)
-    Q_PROPERTY(QString discardTop READ discardTop NOTIFY gameStateChanged)
-    Q_PROPERTY(int drawCount READ drawCount NOTIFY gameStateChanged)
-    Q_PROPERTY(int players READ players NOTIFY gameStateChanged)
-    Q_PROPERTY(int yourIndex READ yourIndex NOTIFY gameStateChanged)
-    Q_PROPERTY(int currentPlayerIndex READ currentPlayerIndex NOTIFY gameStateChanged)
-    Q_PROPERTY(QVariantList handCounts READ handCounts NOTIFY gameStateChanged)
-    Q_PROPERTY(QString currentColor READ currentColor NOTIFY gameStateChanged)
-    Q_PROPERTY(bool finished READ finished NOTIFY gameStateChanged)
-    Q_PROPERTY(int winnerIndex READ winnerIndex NOTIFY gameStateChanged)
-    Q_PROPERTY(QString gameLog READ gameLog NOTIFY gameStateChanged)
-    Q_PROPERTY(bool hasGameLog READ hasGameLog NOTIFY gameStateChanged)
+    // Jede Property hat ein eigenes Signal, das nur bei echter Änderung und höchstens einmal pro Frame kommt.
+    Q_PROPERTY(bool hasGameInit READ hasGameInit NOTIFY hasGameInitChanged)
+    Q_PROPERTY(QString gameCode READ gameCode NOTIFY gameCodeChanged)
+    Q_PROPERTY(HandModel* hand READ hand CONSTANT)
+    Q_PROPERTY(GameHistoryModel* history READ history CONSTANT)
+    Q_PROPERTY(LogExporter* logExporter READ logExporter CONSTANT)
+    Q_PROPERTY(ConnectionStats* connectionStats READ connectionStats CONSTANT)
+    Q_PROPERTY(QString discardTop READ discardTop NOTIFY discardTopChanged)
+    Q_PROPERTY(int drawCount READ drawCount NOTIFY drawCountChanged)
+    Q_PROPERTY(int players READ players NOTIFY playersChanged)
+    Q_PROPERTY(int yourIndex READ yourIndex NOTIFY yourIndexChanged)
+    Q_PROPERTY(int currentPlayerIndex READ currentPlayerIndex NOTIFY currentPlayerIndexChanged)
+    Q_PROPERTY(QVariantList handCounts READ handCounts NOTIFY handCountsChanged)
+    Q_PROPERTY(QString currentColor READ currentColor NOTIFY currentColorChanged)
+    Q_PROPERTY(bool finished READ finished NOTIFY finishedChanged)
+    Q_PROPERTY(int winnerIndex READ winnerIndex NOTIFY winnerIndexChanged)
+    Q_PROPERTY(QString gameLog READ gameLog NOTIFY gameLogChanged)
+    Q_PROPERTY(bool hasGameLog READ hasGameLog NOTIFY gameLogChanged)
+    Q_PROPERTY(bool spectating READ spectating NOTIFY spectatingChanged)
 
 public:
     explicit GameClient(QObject* parent = nullptr);
+    ~GameClient() override;
 
     bool connected() const { return m_connected; }
 
-    bool hasGameInit() const { return m_hasGameInit; }
-    QString gameCode() const { return m_gameCode; }
-    QStringList hand() const { return m_hand; }
-    QString discardTop() const { return m_discardTop; }
-    int drawCount() const { return m_drawCount; }
-    int players() const { return m_players; }
-    int yourIndex() const { return m_yourIndex; }
-    int currentPlayerIndex() const { return m_currentPlayerIndex; }
-    QVariantList handCounts() const { return m_handCounts; }
-    QString currentColor() const { return m_currentColor; }
-    bool finished() const { return m_finished; }
-    int winnerIndex() const { return m_winnerIndex; }
-    QString gameLog() const { return m_gameLog; }
-    bool hasGameLog() const { return !m_gameLog.isEmpty(); }
+    // Zustand kommt aus ClientCore, hier nur für QML umgereicht
+    bool hasGameInit() const { return state().hasGameInit; }
+    QString gameCode() const { return state().gameCode; }
+    HandModel* hand() { return &m_hand; }
+    GameHistoryModel* history() { return &m_history; }
+    LogExporter* logExporter() { return &m_logExporter; }
+    ConnectionStats* connectionStats() { return &m_connectionStats; }
+    QString discardTop() const { return state().discardTop; }
+    int drawCount() const { return state().drawCount; }
+    int players() const { return state().players; }
+    int yourIndex() const { return state().yourIndex; }
+    int currentPlayerIndex() const { return state().currentPlayerIndex; }
+    QVariantList handCounts() const;
+    QString currentColor() const { return state().currentColor; }
+    bool finished() const { return state().finished; }
+    int winnerIndex() const { return state().winnerIndex; }
+    QString gameLog() const { return state().gameLog; }
+    bool hasGameLog() const { return !state().gameLog.isEmpty(); }
+    bool spectating() const { return state().spectating; }
 
     Q_INVOKABLE void connectToServer(const QString& host, int port);
     Q_INVOKABLE void disconnectFromServer();
@@ -53,6 +72,10 @@ public:
     Q_INVOKABLE void createGame();
     Q_INVOKABLE void joinGame(const QString& code);
     Q_INVOKABLE void startGame(const QString& code);
+    Q_INVOKABLE void addBot(const QString& code, bool strong = false);
+    Q_INVOKABLE void spectateGame(const QString& code);
+    Q_INVOKABLE void queueJoin(int tableSize = 2);
+    Q_INVOKABLE void queueLeave();
 
     Q_INVOKABLE void drawCards(int count = 1);
     Q_INVOKABLE void playCard(const QString& card, const QString& chosenColor = QString());
@@ -68,29 +91,62 @@ signals:
     // Events (optional fürs UI)
     void gameCreated(QString code);
     void joinOk(QString code);
-
-    // Wird ausgelöst, wenn Game-State aktualisiert wurde (game_init, draw_cards)
+    void queued(int tableSize);
+    void matchFound(QString code);
+
+    // Einzelne Properties (gesammelt, einmal pro Frame gemeldet)
+    void hasGameInitChanged();
+    void gameCodeChanged();
+    void discardTopChanged();
+    void drawCountChanged();
+    void playersChanged();
+    void yourIndexChanged();
+    void currentPlayerIndexChanged();
+    void handCountsChanged();
+    void currentColorChanged();
+    void finishedChanged();
+    void winnerIndexChanged();
+    void gameLogChanged();
+    void spectatingChanged();
+
+    // Sammelsignal nach den Einzelsignalen: irgendetwas am Spielstand hat sich in diesem Frame geändert
     void gameStateChanged();
 
 private:
-    void sendJson(const QJsonObject& o);
+    static constexpr int FrameIntervalMs = 16;
 
-    QTcpSocket m_sock;
-    QByteArray m_buffer;
+    const ClientState& state() const { return m_core.state(); }
+    ClientCore::Callbacks coreCallbacks();
+    void sendJson(const QJsonObject& o);
+    void scheduleReconnect(int delayMs);
+    void openConnection();
+    void scheduleDrain();
+    void drainEvents();
+    void onConnected();
+    void onDisconnected();
+    void flushChanges();
+
+    // Netzwerk-Thread: liefert geparste Events über die lock-freie Queue
+    QThread m_netThread;
+    NetworkWorker* m_worker = nullptr;
+    SpscQueue<ServerEvent> m_events;
+    QTimer m_frameTimer;
+    QElapsedTimer m_frameClock;
+    quint32 m_generation = 0;
+    bool m_socketActive = false;                // verbindet gerade oder ist verbunden
     bool m_connected = false;
 
-    // Stored state:
-    bool m_hasGameInit = false;
-    QString m_gameCode;
-    QStringList m_hand;
-    QString m_discardTop;
-    int m_drawCount = 0;
-    int m_players = 0;
-    int m_yourIndex = -1;
-    int m_currentPlayerIndex = 0;
-    QVariantList m_handCounts;
-    QString m_currentColor;
-    bool m_finished = false;
-    int m_winnerIndex = -1;
-    QString m_gameLog;
+    // Reconnect: wann und wohin entscheidet ClientCore, hier nur Timer und Adresse
+    QString m_host;
+    int m_port = 0;
+    bool m_userDisconnect = false;
+    QTimer m_reconnectTimer;
+
+    // Protokoll, Spielstand und Vorhersagen (GUI-frei, siehe unoclient/)
+    ClientCore m_core;
+    HandModel m_hand;
+    GameHistoryModel m_history;             // Kartenanzahl pro Spieler über die Zeit (Graph am Ende)
+    LogExporter m_logExporter;
+    ConnectionStats m_connectionStats;
+    QTimer m_pendingTimer;                  // Frist für unbestätigte vorhergesagte Züge
 };
@@ -0,0 +1,71 @@
+#include "gamehistorymodel.h"
+
+GameHistoryModel::GameHistoryModel(QObject* parent) : QAbstractTableModel(parent) {}
+
+int GameHistoryModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+int GameHistoryModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_players;
+}
+
+QVariant GameHistoryModel::data(const QModelIndex& index, int role) const
+{
+    if (role != Qt::DisplayRole || !index.isValid())
+        return QVariant();
+    return value(index.row(), index.column());
+}
+
+int GameHistoryModel::value(int row, int player) const
+{
+    if (row < 0 || row >= m_rows.size() || player < 0 || player >= m_players)
+        return 0;
+    return m_rows.at(row).value(player);
+}
+
+void GameHistoryModel::reset(int players)
+{
+    const bool hadRows = !m_rows.isEmpty();
+    const bool playersChangedNow = players != m_players;
+    const bool maxChanged = m_maxValue != 1;
+
+    beginResetModel();
+    m_rows.clear();
+    m_players = qMax(0, players);
+    m_maxValue = 1;
+    endResetModel();
+
+    if (hadRows) emit countChanged();
+    if (playersChangedNow) emit playersChanged();
+    if (maxChanged) emit maxValueChanged();
+}
+
+//Eine Zeile pro neuem Stand; doppelte Stände (z.B. nach Reconnect) werden übersprungen
+void GameHistoryModel::appendCounts(const QList<int>& counts)
+{
+    if (m_players == 0)
+        return;
+
+    QList<int> row(m_players, 0);
+    int rowMax = 0;
+    for (int i = 0; i < m_players && i < counts.size(); ++i) {
+        row[i] = counts.at(i);
+        rowMax = qMax(rowMax, row[i]);
+    }
+    if (!m_rows.isEmpty() && m_rows.last() == row)
+        return;
+
+    const int pos = m_rows.size();
+    beginInsertRows(QModelIndex(), pos, pos);
+    m_rows.append(row);
+    endInsertRows();
+    emit countChanged();
+
+    if (rowMax > m_maxValue) {
+        m_maxValue = rowMax;
+        emit maxValueChanged();
+    }
+}
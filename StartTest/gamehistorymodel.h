@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QList>
+#include <QtQml/qqmlregistration.h>
+
+// Verlauf der Kartenanzahl pro Spieler: eine Zeile pro Spielstand, eine Spalte pro Spieler.
+// GameClient hängt bei jedem neuen handCounts eine Zeile an, damit der Graph am
+// Spielende sofort fertig ist, statt das Log-CSV in QML zu zerlegen.
+class GameHistoryModel : public QAbstractTableModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("Kommt aus gameClient.history")
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int players READ players NOTIFY playersChanged)
+    Q_PROPERTY(int maxValue READ maxValue NOTIFY maxValueChanged)
+
+public:
+    explicit GameHistoryModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    int count() const { return m_rows.size(); }
+    int players() const { return m_players; }
+    int maxValue() const { return m_maxValue; }
+
+    Q_INVOKABLE int value(int row, int player) const;
+
+    // Neues Spiel: Verlauf leeren, Spaltenanzahl festlegen
+    void reset(int players);
+    // Hängt den Stand an, wenn er sich vom letzten unterscheidet
+    void appendCounts(const QList<int>& counts);
+
+signals:
+    void countChanged();
+    void playersChanged();
+    void maxValueChanged();
+
+private:
+    QList<QList<int>> m_rows;
+    int m_players = 0;
+    int m_maxValue = 1;
+};
@@ -0,0 +1,144 @@
+#include "handcountchart.h"
+
+#include <QColor>
+#include <QMatrix4x4>
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+#include <QSGTransformNode>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+const QColor SeriesColors[] = {
+    QColor("#e74c3c"), QColor("#3498db"), QColor("#2ecc71"),
+    QColor("#f1c40f"), QColor("#9b59b6"), QColor("#e67e22"),
+};
+
+QSGGeometryNode* makeLineNode(const QColor& color, int vertexCount)
+{
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), vertexCount);
+    geometry->setDrawingMode(QSGGeometry::DrawLineStrip);
+    geometry->setLineWidth(2);
+
+    auto* material = new QSGFlatColorMaterial;
+    material->setColor(color);
+
+    auto* node = new QSGGeometryNode;
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+    node->setMaterial(material);
+    node->setFlag(QSGNode::OwnsMaterial);
+    return node;
+}
+
+} // namespace
+
+HandCountChart::HandCountChart(QQuickItem* parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void HandCountChart::setModel(GameHistoryModel* model)
+{
+    if (m_model == model)
+        return;
+    if (m_model)
+        disconnect(m_model, nullptr, this, nullptr);
+
+    m_model = model;
+    if (m_model) {
+        // Neue Zeilen und neues Maximum: nur neu zeichnen, der Node-Baum bleibt
+        connect(m_model, &QAbstractItemModel::rowsInserted, this, &QQuickItem::update);
+        connect(m_model, &GameHistoryModel::maxValueChanged, this, &QQuickItem::update);
+        connect(m_model, &QAbstractItemModel::modelReset, this, &HandCountChart::scheduleRebuild);
+    }
+    scheduleRebuild();
+    emit modelChanged();
+}
+
+void HandCountChart::scheduleRebuild()
+{
+    m_rebuild = true;
+    update();
+}
+
+void HandCountChart::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size())
+        update();
+}
+
+//Läuft im Render-Thread, während der GUI-Thread blockiert ist: Modell darf gelesen werden
+QSGNode* HandCountChart::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*)
+{
+    const int players = m_model ? m_model->players() : 0;
+    const int rows = m_model ? m_model->count() : 0;
+    if (players == 0 || rows == 0 || width() <= 2 * Padding || height() <= 2 * Padding) {
+        delete oldNode;
+        m_syncedRows = 0;
+        return nullptr;
+    }
+
+    // Aufbau: root -> [Achsen, Transform -> eine Linie pro Spieler]
+    QSGNode* root = oldNode;
+    if (root && (m_rebuild || root->lastChild()->childCount() != players)) {
+        delete root;
+        root = nullptr;
+    }
+    if (!root) {
+        root = new QSGNode;
+        root->appendChildNode(makeLineNode(Qt::black, 3));
+        auto* transform = new QSGTransformNode;
+        for (int p = 0; p < players; ++p)
+            transform->appendChildNode(makeLineNode(SeriesColors[p % std::size(SeriesColors)], 0));
+        root->appendChildNode(transform);
+        m_syncedRows = 0;
+        m_rebuild = false;
+    }
+
+    const qreal plotW = width() - 2 * Padding;
+    const qreal plotH = height() - 2 * Padding;
+
+    auto* axes = static_cast<QSGGeometryNode*>(root->firstChild());
+    QSGGeometry::Point2D* a = axes->geometry()->vertexDataAsPoint2D();
+    a[0].set(Padding, Padding);
+    a[1].set(Padding, Padding + plotH);
+    a[2].set(Padding + plotW, Padding + plotH);
+    axes->markDirty(QSGNode::DirtyGeometry);
+
+    // Neue Zeilen anhängen; Reserve wird mit dem letzten Punkt gefüllt (unsichtbare Nullsegmente)
+    auto* transform = static_cast<QSGTransformNode*>(root->lastChild());
+    if (rows != m_syncedRows) {
+        int p = 0;
+        for (QSGNode* child = transform->firstChild(); child; child = child->nextSibling(), ++p) {
+            auto* line = static_cast<QSGGeometryNode*>(child);
+            QSGGeometry* geometry = line->geometry();
+            if (geometry->vertexCount() < rows) {
+                const int capacity = qMax(16, rows * 2);
+                QList<QSGGeometry::Point2D> keep(geometry->vertexDataAsPoint2D(),
+                                                 geometry->vertexDataAsPoint2D() + m_syncedRows);
+                geometry->allocate(capacity);
+                std::copy(keep.cbegin(), keep.cend(), geometry->vertexDataAsPoint2D());
+            }
+            QSGGeometry::Point2D* v = geometry->vertexDataAsPoint2D();
+            for (int r = m_syncedRows; r < rows; ++r)
+                v[r].set(float(r), float(m_model->value(r, p)));
+            for (int r = rows; r < geometry->vertexCount(); ++r)
+                v[r] = v[rows - 1];
+            line->markDirty(QSGNode::DirtyGeometry);
+        }
+        m_syncedRows = rows;
+    }
+
+    // Datenkoordinaten -> Pixel: nur die Matrix hängt von Größe, Punktanzahl und Maximum ab
+    const qreal maxVal = qMax(1, m_model->maxValue());
+    QMatrix4x4 m;
+    m.translate(float(Padding), float(Padding + plotH));
+    m.scale(rows > 1 ? float(plotW / (rows - 1)) : 1.0f, float(-plotH / maxVal));
+    transform->setMatrix(m);
+
+    return root;
+}
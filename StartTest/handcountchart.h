@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QPointer>
+#include <QQuickItem>
+
+#include "gamehistorymodel.h"
+
+// Liniendiagramm der Kartenanzahl pro Spieler direkt im Scene-Graph.
+// Die Punkte liegen in Datenkoordinaten (x = Zeile, y = Karten) unter einem
+// Transform-Node: neue Zeilen schreiben nur ihre eigenen Vertices, Größe oder
+// Maximum ändern nur die Matrix.
+class HandCountChart : public QQuickItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+    Q_PROPERTY(GameHistoryModel* model READ model WRITE setModel NOTIFY modelChanged)
+
+public:
+    static constexpr qreal Padding = 20.0;
+
+    explicit HandCountChart(QQuickItem* parent = nullptr);
+
+    GameHistoryModel* model() const { return m_model; }
+    void setModel(GameHistoryModel* model);
+
+signals:
+    void modelChanged();
+
+protected:
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+
+private:
+    void scheduleRebuild();
+
+    QPointer<GameHistoryModel> m_model;
+    bool m_rebuild = true;          // Modell ersetzt/zurückgesetzt: Nodes neu aufbauen
+    int m_syncedRows = 0;           // so viele Zeilen stehen schon in der Geometrie
+};
@@ -0,0 +1,88 @@
+#include "handmodel.h"
+
+HandModel::HandModel(ClientHand* hand, QObject* parent) : QAbstractListModel(parent), m_hand(hand)
+{
+    m_hand->setListener(this);
+}
+
+HandModel::~HandModel()
+{
+    m_hand->setListener(nullptr);
+}
+
+int HandModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_hand->count();
+}
+
+QVariant HandModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_hand->count())
+        return QVariant();
+
+    const ClientHand::Card& card = m_hand->at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+    case CardIdRole:
+        return card.id;
+    case ImageSourceRole:
+        return QStringLiteral("image://cards/") + card.id;
+    case PlayableRole:
+        return card.playable;
+    case NeedsColorRole:
+        return card.index >= 0 && CardCatalog::isWild(card.index);
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> HandModel::roleNames() const
+{
+    return {
+        {CardIdRole, "cardId"},
+        {ImageSourceRole, "imageSource"},
+        {PlayableRole, "playable"},
+        {NeedsColorRole, "needsColor"},
+    };
+}
+
+void HandModel::handAboutToReset()
+{
+    m_countBeforeReset = m_hand->count();
+    beginResetModel();
+}
+
+void HandModel::handReset()
+{
+    endResetModel();
+    if (m_countBeforeReset != m_hand->count())
+        emit countChanged();
+}
+
+void HandModel::handAboutToInsert(int first, int last)
+{
+    beginInsertRows(QModelIndex(), first, last);
+}
+
+void HandModel::handInserted()
+{
+    endInsertRows();
+    emit countChanged();
+}
+
+void HandModel::handAboutToRemove(int row)
+{
+    beginRemoveRows(QModelIndex(), row, row);
+}
+
+void HandModel::handRemoved()
+{
+    endRemoveRows();
+    emit countChanged();
+}
+
+void HandModel::handPlayableChanged(int row)
+{
+    const QModelIndex idx = index(row);
+    emit dataChanged(idx, idx, {PlayableRole});
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QStringList>
+
+#include "clienthand.h"
+
+// Ansicht der eigenen Hand (ClientHand aus unoclient) als ListModel: gezogene/gelegte
+// Karten fügen genau eine Zeile ein bzw. entfernen sie, statt die ganze Liste zu ersetzen.
+// So erzeugt der Repeater in GamePage nur die Delegates neu, die sich wirklich geändert haben.
+class HandModel : public QAbstractListModel, private ClientHand::Listener
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Roles {
+        CardIdRole = Qt::UserRole + 1,
+        ImageSourceRole,
+        PlayableRole,
+        NeedsColorRole,
+    };
+
+    explicit HandModel(ClientHand* hand, QObject* parent = nullptr);
+    ~HandModel() override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return m_hand->count(); }
+    QStringList cards() const { return m_hand->cards(); }
+
+signals:
+    void countChanged();
+
+private:
+    void handAboutToReset() override;
+    void handReset() override;
+    void handAboutToInsert(int first, int last) override;
+    void handInserted() override;
+    void handAboutToRemove(int row) override;
+    void handRemoved() override;
+    void handPlayableChanged(int row) override;
+
+    ClientHand* m_hand;
+    int m_countBeforeReset = 0;
+};
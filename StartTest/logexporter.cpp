@@ -0,0 +1,326 @@
+#include "logexporter.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QHash>
+#include <QPointer>
+#include <QSaveFile>
+#include <QStringView>
+#include <QThreadPool>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+constexpr qsizetype ChunkSize = 64 * 1024;
+
+// Ziel eines Exports: puffert, schreibt in Blöcken und committet erst am Ende (QSaveFile)
+class Sink
+{
+public:
+    explicit Sink(const QString& path) : m_file(path) {}
+    virtual ~Sink() = default;
+
+    bool open() { return m_file.open(QIODevice::WriteOnly); }
+    QString errorString() const { return m_error.isEmpty() ? m_file.errorString() : m_error; }
+
+    bool append(const QByteArray& bytes)
+    {
+        m_buffer += bytes;
+        return m_buffer.size() < ChunkSize || flush();
+    }
+
+    bool finish()
+    {
+        return flush() && finishStream() && m_file.commit();
+    }
+
+protected:
+    virtual bool writeChunk(const QByteArray& chunk) { return m_file.write(chunk) == chunk.size(); }
+    virtual bool finishStream() { return true; }
+
+    bool flush()
+    {
+        if (m_buffer.isEmpty())
+            return true;
+        const bool ok = writeChunk(m_buffer);
+        m_buffer.clear();
+        return ok;
+    }
+
+    QSaveFile m_file;
+    QString m_error;
+
+private:
+    QByteArray m_buffer;
+};
+
+#ifdef HAVE_ZLIB
+// gzip-Container über zlib (windowBits 15 + 16), komprimiert Block für Block
+class GzipSink : public Sink
+{
+public:
+    explicit GzipSink(const QString& path) : Sink(path)
+    {
+        m_ok = deflateInit2(&m_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+        if (!m_ok)
+            m_error = "zlib init failed";
+    }
+    ~GzipSink() override { deflateEnd(&m_stream); }
+
+protected:
+    bool writeChunk(const QByteArray& chunk) override { return deflateChunk(chunk, Z_NO_FLUSH); }
+    bool finishStream() override { return deflateChunk(QByteArray(), Z_FINISH); }
+
+private:
+    bool deflateChunk(const QByteArray& chunk, int flush)
+    {
+        if (!m_ok)
+            return false;
+        m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(chunk.constData()));
+        m_stream.avail_in = uInt(chunk.size());
+        char out[16 * 1024];
+        int rc = Z_OK;
+        do {
+            m_stream.next_out = reinterpret_cast<Bytef*>(out);
+            m_stream.avail_out = sizeof(out);
+            rc = deflate(&m_stream, flush);
+            if (rc == Z_STREAM_ERROR) {
+                m_error = "zlib deflate failed";
+                return false;
+            }
+            const qint64 produced = qint64(sizeof(out) - m_stream.avail_out);
+            if (produced > 0 && m_file.write(out, produced) != produced)
+                return false;
+        } while (m_stream.avail_out == 0 || (flush == Z_FINISH && rc != Z_STREAM_END));
+        return true;
+    }
+
+    z_stream m_stream {};
+    bool m_ok = false;
+};
+#endif
+
+void putVarint(QByteArray& out, quint64 v)
+{
+    while (v >= 0x80) {
+        out.append(char(v | 0x80));
+        v >>= 7;
+    }
+    out.append(char(v));
+}
+
+void putZigzag(QByteArray& out, qint64 v)
+{
+    putVarint(out, (quint64(v) << 1) ^ quint64(v >> 63));
+}
+
+void putString(QByteArray& out, QStringView s)
+{
+    const QByteArray utf8 = s.toUtf8();
+    putVarint(out, quint64(utf8.size()));
+    out += utf8;
+}
+
+// Zerlegt eine Log-Zeile und hängt sie binär an; Event-Namen landen beim ersten Auftreten in der Tabelle
+class BinaryEncoder
+{
+public:
+    QByteArray header() const
+    {
+        QByteArray h("UNOL");
+        h.append(char(LogExporter::BinaryVersion));
+        return h;
+    }
+
+    QByteArray encode(QStringView line)
+    {
+        const qsizetype c1 = line.indexOf(u',');
+        const qsizetype c2 = c1 < 0 ? -1 : line.indexOf(u',', c1 + 1);
+        const qsizetype c3 = c2 < 0 ? -1 : line.indexOf(u',', c2 + 1);
+        if (c3 < 0)
+            return QByteArray();
+
+        const qint64 ms = QDateTime::fromString(line.left(c1).toString(), Qt::ISODate).toMSecsSinceEpoch();
+        const QString event = line.mid(c1 + 1, c2 - c1 - 1).toString();
+        const int playerIndex = line.mid(c2 + 1, c3 - c2 - 1).toInt();
+
+        QByteArray out;
+        putZigzag(out, m_lastMs < 0 ? ms : ms - m_lastMs);
+        m_lastMs = ms;
+
+        auto it = m_events.constFind(event);
+        if (it != m_events.cend()) {
+            putVarint(out, quint64(*it));
+        } else {
+            const int index = int(m_events.size());
+            m_events.insert(event, index);
+            putVarint(out, quint64(index));
+            putString(out, event);
+        }
+        putZigzag(out, playerIndex);
+        putString(out, line.mid(c3 + 1));
+        return out;
+    }
+
+private:
+    QHash<QString, int> m_events;
+    qint64 m_lastMs = -1;
+};
+
+} // namespace
+
+LogExporter::LogExporter(QObject* parent) : QObject(parent) {}
+
+LogExporter::~LogExporter()
+{
+    if (m_cancel)
+        m_cancel->store(true);
+}
+
+LogExporter::Format LogExporter::formatForPath(const QString& path)
+{
+    const QString lower = path.toLower();
+    if (lower.endsWith(".gz"))
+        return CsvGzip;
+    if (lower.endsWith(".unolog"))
+        return Binary;
+    return Csv;
+}
+
+bool LogExporter::gzipAvailable()
+{
+#ifdef HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+//Startet den Export im Thread-Pool; Fortschritt und Ergebnis kommen per Queued-Call zurück
+bool LogExporter::start(const QString& path, const QString& log, Format format)
+{
+    if (m_busy || path.isEmpty() || log.isEmpty())
+        return false;
+
+    const quint64 jobId = ++m_jobId;
+    m_cancel = std::make_shared<std::atomic_bool>(false);
+    m_busy = true;
+    m_progress = 0.0;
+    emit busyChanged();
+    emit progressChanged();
+
+    QPointer<LogExporter> self(this);
+    auto cancel = m_cancel;
+    QThreadPool::globalInstance()->start([self, cancel, jobId, path, log, format]() {
+        auto report = [self, jobId](bool ok, const QString& message) {
+            QMetaObject::invokeMethod(qApp, [self, jobId, ok, message]() {
+                if (self) self->onDone(jobId, ok, message);
+            }, Qt::QueuedConnection);
+        };
+
+        std::unique_ptr<Sink> sink;
+        if (format == CsvGzip) {
+#ifdef HAVE_ZLIB
+            sink = std::make_unique<GzipSink>(path);
+#else
+            report(false, "gzip wird in diesem Build nicht unterstützt");
+            return;
+#endif
+        } else {
+            sink = std::make_unique<Sink>(path);
+        }
+        if (!sink->open()) {
+            report(false, sink->errorString());
+            return;
+        }
+
+        BinaryEncoder binary;
+        if (format == Binary && !sink->append(binary.header())) {
+            report(false, sink->errorString());
+            return;
+        }
+
+        // Zeilenweise durchs Log, ohne es vorher komplett zu zerlegen
+        const QStringView all(log);
+        const qsizetype total = all.size();
+        qsizetype pos = 0;
+        int lastPercent = 0;
+        bool headerSkipped = false;
+        while (pos < total) {
+            if (cancel->load()) {
+                report(false, "Export abgebrochen");
+                return;         // QSaveFile ohne commit: Zieldatei bleibt unverändert
+            }
+
+            qsizetype end = all.indexOf(u'\n', pos);
+            if (end < 0)
+                end = total;
+            const QStringView line = all.mid(pos, end - pos);
+            pos = end + 1;
+
+            QByteArray bytes;
+            if (format == Binary) {
+                if (!headerSkipped && line.startsWith(u"timestamp,")) {
+                    headerSkipped = true;
+                    continue;
+                }
+                headerSkipped = true;
+                bytes = binary.encode(line);
+            } else {
+                bytes = line.toUtf8();
+                bytes.append('\n');
+            }
+            if (!bytes.isEmpty() && !sink->append(bytes)) {
+                report(false, sink->errorString());
+                return;
+            }
+
+            const int percent = int(qMin(pos, total) * 100 / total);
+            if (percent != lastPercent) {
+                lastPercent = percent;
+                QMetaObject::invokeMethod(qApp, [self, jobId, percent]() {
+                    if (self) self->onProgress(jobId, percent / 100.0);
+                }, Qt::QueuedConnection);
+            }
+        }
+
+        if (!sink->finish()) {
+            report(false, sink->errorString());
+            return;
+        }
+        report(true, QFileInfo(path).fileName());
+    });
+    return true;
+}
+
+void LogExporter::cancel()
+{
+    if (m_busy && m_cancel)
+        m_cancel->store(true);
+}
+
+void LogExporter::onProgress(quint64 jobId, qreal progress)
+{
+    if (jobId != m_jobId || !m_busy || qFuzzyCompare(progress, m_progress))
+        return;
+    m_progress = progress;
+    emit progressChanged();
+}
+
+void LogExporter::onDone(quint64 jobId, bool ok, const QString& message)
+{
+    if (jobId != m_jobId)
+        return;
+    m_busy = false;
+    m_cancel.reset();
+    if (ok && m_progress < 1.0) {
+        m_progress = 1.0;
+        emit progressChanged();
+    }
+    emit busyChanged();
+    emit finished(ok, message);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QtQml/qqmlregistration.h>
+
+#include <atomic>
+#include <memory>
+
+// Schreibt das Spiel-Log im Hintergrund (globaler Thread-Pool) zeilenweise auf die Platte,
+// statt den GUI-Thread mit einem großen QTextStream-Write zu blockieren.
+//
+// Formate:
+//  - Csv:     wie vom Server geliefert ("timestamp,event,playerIndex,detail")
+//  - CsvGzip: dasselbe als .csv.gz (nur wenn mit zlib gebaut)
+//  - Binary:  "UNOL", Version (1 Byte), danach pro Zeile:
+//             varint zigzag(ms seit letzter Zeile), varint Event-Index
+//             (neuer Index = Tabellengröße, gefolgt vom Namen als varint-Länge + UTF-8),
+//             varint zigzag(playerIndex), varint-Länge + UTF-8 detail
+class LogExporter : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("Kommt aus gameClient.logExporter")
+    Q_PROPERTY(bool busy READ busy NOTIFY busyChanged)
+    Q_PROPERTY(qreal progress READ progress NOTIFY progressChanged)
+
+public:
+    enum Format { Csv, CsvGzip, Binary };
+    Q_ENUM(Format)
+
+    static constexpr int BinaryVersion = 1;
+
+    explicit LogExporter(QObject* parent = nullptr);
+    ~LogExporter() override;
+
+    bool busy() const { return m_busy; }
+    qreal progress() const { return m_progress; }
+
+    // Format aus der Endung: .gz -> CsvGzip, .unolog -> Binary, sonst Csv
+    static Format formatForPath(const QString& path);
+    static bool gzipAvailable();
+
+    // Startet den Export; false, wenn schon einer läuft oder nichts zu schreiben ist
+    bool start(const QString& path, const QString& log, Format format);
+    Q_INVOKABLE void cancel();
+
+signals:
+    void busyChanged();
+    void progressChanged();
+    void finished(bool ok, const QString& message);
+
+private:
+    void onProgress(quint64 jobId, qreal progress);
+    void onDone(quint64 jobId, bool ok, const QString& message);
+
+    std::shared_ptr<std::atomic_bool> m_cancel;
+    quint64 m_jobId = 0;
+    bool m_busy = false;
+    qreal m_progress = 0.0;
+};
@@ -1,9 +1,11 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QStandardPaths>
 
 #include "linkservice.h"
 #include "gameclient.h"
+#include "cardimageprovider.h"
 
 int main(int argc, char *argv[])
 {
@@ -18,6 +20,11 @@ int main(int argc, char *argv[])
     GameClient gameClient;
     engine.rootContext()->setContextProperty("gameClient", &gameClient);
 
+    //Alle Kartenbilder kommen aus einem Atlas (image://cards/<id>), asynchron dekodiert und
+    //pro Größe im Speicher und im Cache-Ordner abgelegt. Engine übernimmt den Provider.
+    engine.addImageProvider("cards", new CardImageProvider(
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation)));
+
     engine.loadFromModule("StartTest", "Main");
     if (engine.rootObjects().isEmpty())
         return -1;
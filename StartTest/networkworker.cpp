@@ -0,0 +1,139 @@
+#include "networkworker.h"
+
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QTcpSocket>
+#include <QThread>
+
+NetworkWorker::NetworkWorker(SpscQueue<ServerEvent>* queue, QObject* parent)
+    : QObject(parent), m_queue(queue)
+{
+}
+
+//Neue Verbindung; eine alte wird vorher abgebrochen (ihre Events tragen noch die alte Nummer)
+void NetworkWorker::connectToHost(const QString& host, quint16 port, quint32 generation)
+{
+    if (!m_sock) {
+        m_sock = new QTcpSocket(this);
+        // Begrenzter Lesepuffer: ist die Queue voll, staut sich der Rest im Kernel
+        m_sock->setReadBufferSize(256 * 1024);
+        connect(m_sock, &QTcpSocket::readyRead, this, &NetworkWorker::onReadyRead);
+        connect(m_sock, &QTcpSocket::connected, this, [this]() { pushControl(ServerEvent::Kind::Connected); });
+        connect(m_sock, &QTcpSocket::disconnected, this, [this]() { pushControl(ServerEvent::Kind::Disconnected); });
+        connect(m_sock, &QTcpSocket::errorOccurred, this, [this](QAbstractSocket::SocketError) {
+            pushControl(ServerEvent::Kind::SocketError, m_sock->errorString(),
+                        m_sock->state() == QAbstractSocket::UnconnectedState);
+        });
+    }
+
+    m_sock->abort();
+    m_generation = generation;
+    m_buffer.clear();
+    m_consumed = 0;
+    m_stalled.store(false, std::memory_order_release);
+    m_sock->connectToHost(host, port);
+}
+
+void NetworkWorker::disconnectFromHost()
+{
+    if (m_sock)
+        m_sock->disconnectFromHost();
+}
+
+void NetworkWorker::write(const QByteArray& payload)
+{
+    if (!m_sock)
+        return;
+    m_sock->write(payload);
+    m_sock->flush();
+}
+
+void NetworkWorker::onReadyRead()
+{
+    // Queue voll: nicht weiterlesen, bis der GUI-Thread Platz geschaffen hat
+    if (m_stalled.load(std::memory_order_acquire))
+        return;
+    m_buffer += m_sock->readAll();
+    processPending();
+}
+
+//Zerlegt den Puffer in Zeilen und parst sie. Abgeschnitten wird einmal pro Durchgang, nicht pro Zeile
+void NetworkWorker::processPending()
+{
+    // m_stalled wird erst am Ende neu gesetzt: doppelte, veraltete Aufrufe aus drainEvents
+    // dürfen einen Stau nicht löschen und dann wieder setzen, ohne den GUI-Thread zu wecken
+    bool pushed = false;
+    bool full = false;
+    const qint64 receivedMs = QDateTime::currentMSecsSinceEpoch();
+
+    while (true) {
+        const int nl = m_buffer.indexOf('\n', m_consumed);
+        if (nl < 0)
+            break;
+        if (m_queue->isFull()) {
+            full = true;
+            break;
+        }
+
+        const QByteArray line = QByteArrayView(m_buffer).sliced(m_consumed, nl - m_consumed).trimmed().toByteArray();
+        m_consumed = nl + 1;
+        if (line.isEmpty())
+            continue;
+
+        ServerEvent ev;
+        ev.generation = m_generation;
+        ev.receivedMs = receivedMs;
+        QJsonParseError err;
+        const QJsonDocument doc = QJsonDocument::fromJson(line, &err);
+        if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+            ev.kind = ServerEvent::Kind::InvalidJson;
+        } else {
+            ev.payload = doc.object();
+            ev.typeName = ev.payload.value("type").toString();
+            ev.message = serverMessageFromType(ev.typeName);
+        }
+        m_queue->tryPush(std::move(ev));
+        pushed = true;
+    }
+
+    if (m_consumed > 0) {
+        m_buffer.remove(0, m_consumed);
+        m_consumed = 0;
+    }
+    if (full) {
+        // Immer wecken: der GUI-Thread muss den Stau sehen, auch wenn er die Queue schon geleert hat
+        m_stalled.store(true, std::memory_order_release);
+        notify();
+    } else {
+        m_stalled.store(false, std::memory_order_release);
+        if (pushed)
+            notify();
+    }
+
+    // Nach einem Stau: was inzwischen im Socket liegt, jetzt abholen
+    if (!m_stalled.load(std::memory_order_acquire) && m_sock && m_sock->bytesAvailable() > 0)
+        QMetaObject::invokeMethod(this, &NetworkWorker::onReadyRead, Qt::QueuedConnection);
+}
+
+//Verbindungs-Events dürfen nicht verloren gehen: notfalls warten, bis der GUI-Thread Platz macht
+void NetworkWorker::pushControl(ServerEvent::Kind kind, const QString& errorText, bool unconnected)
+{
+    ServerEvent ev;
+    ev.kind = kind;
+    ev.generation = m_generation;
+    ev.errorText = errorText;
+    ev.unconnected = unconnected;
+    while (!m_queue->tryPush(std::move(ev))) {
+        if (QThread::currentThread()->isInterruptionRequested())
+            return;
+        notify();
+        QThread::msleep(1);
+    }
+    notify();
+}
+
+void NetworkWorker::notify()
+{
+    if (!m_wakePending.exchange(true, std::memory_order_acq_rel))
+        emit eventsAvailable();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+
+#include "protocol.h"
+#include "spscqueue.h"
+
+class QTcpSocket;
+
+struct ServerEvent {
+    enum class Kind : quint8 { Connected, Disconnected, SocketError, Message, InvalidJson };
+
+    Kind kind = Kind::Message;
+    quint32 generation = 0;                     // Verbindungsnummer; Events alter Verbindungen verwirft der Client
+    ServerMessage message = ServerMessage::Unknown;
+    QString typeName;
+    QJsonObject payload;
+    QString errorText;
+    bool unconnected = false;                   // SocketError: Socket ist danach nicht verbunden
+    qint64 receivedMs = 0;                      // Empfangszeit im Netzwerk-Thread (Epoch-ms), für ping/pong
+};
+
+// Socket, Zeilen-Framing und JSON-Parsing im eigenen Thread. Fertige Events landen
+// in der SPSC-Queue; der GUI-Thread wird höchstens einmal pro Schub geweckt.
+// Alle Methoden außer isStalled/clearWake laufen im Netzwerk-Thread (per invokeMethod).
+class NetworkWorker : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int QueueCapacity = 1024;
+
+    explicit NetworkWorker(SpscQueue<ServerEvent>* queue, QObject* parent = nullptr);
+
+    void connectToHost(const QString& host, quint16 port, quint32 generation);
+    void disconnectFromHost();
+    void write(const QByteArray& payload);
+    void processPending();
+
+    // Thread-sicher (GUI-Thread)
+    bool isStalled() const { return m_stalled.load(std::memory_order_acquire); }
+    // exchange statt store: synchronisiert mit notify(), danach ist ein gesetztes m_stalled sichtbar
+    void clearWake() { m_wakePending.exchange(false, std::memory_order_acq_rel); }
+
+signals:
+    void eventsAvailable();
+
+private:
+    void onReadyRead();
+    void pushControl(ServerEvent::Kind kind, const QString& errorText = QString(), bool unconnected = false);
+    void notify();
+
+    SpscQueue<ServerEvent>* m_queue;
+    QTcpSocket* m_sock = nullptr;
+    QByteArray m_buffer;
+    int m_consumed = 0;                         // bis hier ist m_buffer schon verarbeitet
+    quint32 m_generation = 0;
+    std::atomic<bool> m_stalled{false};
+    std::atomic<bool> m_wakePending{false};
+};
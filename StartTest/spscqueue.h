@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Lock-freie Ringpuffer-Queue für genau einen Producer- und einen Consumer-Thread.
+// Kapazität ist eine Zweierpotenz; ist die Queue voll, schlägt tryPush fehl und
+// der Producer muss warten (kein Verwerfen von Events).
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacityPow2)
+        : m_slots(new T[capacityPow2]), m_mask(capacityPow2 - 1)
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Nur Producer
+    bool isFull() const
+    {
+        return m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_acquire) > m_mask;
+    }
+
+    bool tryPush(T&& value)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) > m_mask)
+            return false;
+        m_slots[head & m_mask] = std::move(value);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Nur Consumer. Der Slot wird geleert, damit große Payloads nicht im Ring hängen bleiben
+    bool tryPop(T& out)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+            return false;
+        out = std::move(m_slots[tail & m_mask]);
+        m_slots[tail & m_mask] = T();
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::unique_ptr<T[]> m_slots;
+    const std::size_t m_mask;
+    alignas(64) std::atomic<std::size_t> m_head{0};   // nächster Schreibplatz (Producer)
+    alignas(64) std::atomic<std::size_t> m_tail{0};   // nächster Leseplatz (Consumer)
+};
@@ -5,9 +5,40 @@ CONFIG -= app_bundle
 TEMPLATE = app
 TARGET = UNOServer
 
+# Kartenkatalog und Zugregeln, gemeinsam mit dem Client
+include(../unorules/unorules.pri)
+
 SOURCES += \
+    botplayer.cpp \
+    broadcastgroup.cpp \
+    fastgame.cpp \
+    fdhandoff.cpp \
+    gamemanager.cpp \
+    gamesnapshot.cpp \
+    hashring.cpp \
+    hotrestart.cpp \
+    ismcts.cpp \
+    latencyhistogram.cpp \
     main.cpp \
-    server.cpp
+    matchmaker.cpp \
+    router.cpp \
+    server.cpp \
+    tokenbucket.cpp
 
 HEADERS += \
-    server.h
+    botplayer.h \
+    broadcastgroup.h \
+    clientconnection.h \
+    fastgame.h \
+    fdhandoff.h \
+    gamemanager.h \
+    gamesnapshot.h \
+    hashring.h \
+    hotrestart.h \
+    ismcts.h \
+    latencyhistogram.h \
+    matchmaker.h \
+    router.h \
+    server.h \
+    serverconfig.h \
+    tokenbucket.h
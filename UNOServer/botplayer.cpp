@@ -0,0 +1,61 @@
+#include "botplayer.h"
+
+using CardCatalog::Color;
+using CardCatalog::Value;
+
+//Bewertet alle legalen Karten und nimmt die beste. Extra-Karten werden aufgehoben, außer der nächste Spieler ist fast fertig
+BotMove BotPlayer::chooseMove(const QStringList& hand, QStringView topDiscard,
+                              QStringView currentColor, int nextPlayerHandCount)
+{
+    const int topIndex = topDiscard.isEmpty() ? -1 : CardCatalog::indexOf(topDiscard);
+    const Color color = CardCatalog::colorFromName(currentColor);
+
+    int colorCounts[4] = {0, 0, 0, 0};
+    for (const QString& c : hand) {
+        const int idx = CardCatalog::indexOf(c);
+        if (idx >= 0 && !CardCatalog::isWild(idx))
+            ++colorCounts[int(CardCatalog::card(idx).color)];
+    }
+
+    const bool nextAlmostDone = nextPlayerHandCount <= 2;
+    BotMove best;
+    int bestScore = 0;
+
+    for (int i = 0; i < hand.size(); ++i) {
+        const int idx = CardCatalog::indexOf(hand.at(i));
+        if (!CardCatalog::isLegal(idx, topIndex, color))
+            continue;
+
+        const CardCatalog::Card& c = CardCatalog::card(idx);
+        int score = 0;
+        switch (c.value) {
+        case Value::DrawFour:
+            score = nextAlmostDone ? 30 : 2;
+            break;
+        case Value::ColorChange:
+            score = 3;
+            break;
+        case Value::Skip:
+        case Value::Reverse:
+            score = (nextAlmostDone ? 25 : 8) + colorCounts[int(c.color)];
+            break;
+        default:
+            score = 10 + colorCounts[int(c.color)];
+            break;
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            best.handIndex = i;
+        }
+    }
+
+    // Bei Extra-Karten die Farbe nehmen, von der der Bot am meisten hat
+    int bestColor = 0;
+    for (int col = 1; col < 4; ++col) {
+        if (colorCounts[col] > colorCounts[bestColor])
+            bestColor = col;
+    }
+    best.chosenColor = Color(bestColor);
+    return best;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <QStringList>
+#include <QStringView>
+
+#include "cardcatalog.h"
+
+struct BotMove {
+    int handIndex = -1;                         // -1 = Karte ziehen
+    CardCatalog::Color chosenColor = CardCatalog::Color::Rot;
+};
+
+// Einfacher Server-Bot. Die Zugwahl arbeitet nur auf Kartenindizes und Stack-Arrays
+// (keine Heap-Allokation) und prüft mit denselben Regeln wie der Server.
+class BotPlayer {
+public:
+    static BotMove chooseMove(const QStringList& hand, QStringView topDiscard,
+                              QStringView currentColor, int nextPlayerHandCount);
+};
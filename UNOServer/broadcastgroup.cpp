@@ -0,0 +1,50 @@
+#include "broadcastgroup.h"
+
+BroadcastGroup::BroadcastGroup(int capacity)
+{
+    m_ring.resize(qMax(1, capacity));
+}
+
+//Nimmt einen Empfänger in die Gruppe auf
+void BroadcastGroup::add(QTcpSocket* sock)
+{
+    if (!m_members.contains(sock)) {
+        m_members.append(sock);
+        m_firstSeq.insert(sock, m_nextSeq);
+    }
+}
+
+//Entfernt einen Empfänger aus der Gruppe
+bool BroadcastGroup::remove(QTcpSocket* sock)
+{
+    m_firstSeq.remove(sock);
+    return m_members.removeOne(sock);
+}
+
+//Hängt ein Event hinten an den Ring, bei vollem Ring fällt das älteste heraus
+bool BroadcastGroup::enqueue(const QByteArray& payload, bool supersedable, qint64 dueMs, QTcpSocket* target)
+{
+    bool kept = true;
+    if (m_count == m_ring.size()) {
+        m_ring[m_head] = DelayedEvent();
+        m_head = (m_head + 1) % m_ring.size();
+        --m_count;
+        ++m_dropped;
+        kept = false;
+    }
+
+    DelayedEvent& slot = m_ring[(m_head + m_count) % m_ring.size()];
+    slot.dueMs = dueMs;
+    slot.seq = m_nextSeq++;
+    slot.payload = payload;
+    slot.target = target;
+    slot.supersedable = supersedable;
+    ++m_count;
+    return kept;
+}
+
+//Fälligkeit des ältesten offenen Events
+qint64 BroadcastGroup::nextDueMs() const
+{
+    return m_count > 0 ? m_ring[m_head].dueMs : -1;
+}
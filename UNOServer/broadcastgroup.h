@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QList>
+#include <QHash>
+#include <QByteArray>
+
+class QTcpSocket;
+
+// Empfängergruppe (z.B. Zuschauer eines Spiels). Jedes Event wird einmal serialisiert
+// und als geteiltes QByteArray an alle Mitglieder gegeben. Events liegen bis zu ihrer
+// Fälligkeit in einem Ringpuffer fester Größe (für verzögerte Übertragungen).
+// Ein neues Mitglied bekommt nur Events, die nach seinem Beitritt eingereiht wurden,
+// sonst liefe seine (verzögerte) Sicht nach dem Einstiegsstand wieder rückwärts.
+class BroadcastGroup {
+public:
+    explicit BroadcastGroup(int capacity = 512);
+
+    void add(QTcpSocket* sock);
+    bool remove(QTcpSocket* sock);
+    bool contains(QTcpSocket* sock) const { return m_members.contains(sock); }
+    bool isEmpty() const { return m_members.isEmpty(); }
+    int size() const { return m_members.size(); }
+    const QList<QTcpSocket*>& members() const { return m_members; }
+
+    // Reiht ein Event ein, das ab dueMs zugestellt wird, an alle oder nur an target.
+    // Gibt false zurück, wenn dafür das älteste Event verworfen werden musste (Ring voll).
+    bool enqueue(const QByteArray& payload, bool supersedable, qint64 dueMs, QTcpSocket* target = nullptr);
+    qint64 nextDueMs() const;                   // -1 = nichts offen
+    quint64 dropped() const { return m_dropped; }
+
+    // Stellt alle fälligen Events in Reihenfolge zu: deliver(QTcpSocket*, const QByteArray&, bool supersedable)
+    template <typename Deliver>
+    void deliverDue(qint64 nowMs, Deliver deliver)
+    {
+        while (m_count > 0) {
+            DelayedEvent& ev = m_ring[m_head];
+            if (ev.dueMs > nowMs)
+                break;
+            if (ev.target) {
+                if (m_members.contains(ev.target))
+                    deliver(ev.target, ev.payload, ev.supersedable);
+            } else {
+                for (QTcpSocket* s : m_members) {
+                    if (ev.seq >= m_firstSeq.value(s))
+                        deliver(s, ev.payload, ev.supersedable);
+                }
+            }
+            ev = DelayedEvent();
+            m_head = (m_head + 1) % m_ring.size();
+            --m_count;
+        }
+    }
+
+private:
+    struct DelayedEvent {
+        qint64 dueMs = 0;
+        quint64 seq = 0;
+        QByteArray payload;
+        QTcpSocket* target = nullptr;           // nullptr = alle Mitglieder
+        bool supersedable = false;
+    };
+
+    QList<QTcpSocket*> m_members;
+    QHash<QTcpSocket*, quint64> m_firstSeq;     // erstes Event, das ein Mitglied bekommt
+    quint64 m_nextSeq = 0;
+    QList<DelayedEvent> m_ring;
+    int m_head = 0;
+    int m_count = 0;
+    quint64 m_dropped = 0;
+};
@@ -0,0 +1,121 @@
+#include "fastgame.h"
+#include "rules.h"
+
+using CardCatalog::Color;
+
+//Sammelt die erlaubten Züge, ohne zu allokieren
+void FastGame::legalMoves(FastMoveList& out) const
+{
+    out.size = 0;
+    quint64 hand = hands[current];
+    while (hand) {
+        const int idx = qCountTrailingZeroBits(hand);
+        hand &= hand - 1;
+        if (!CardCatalog::isLegal(idx, top, Color(currentColor)))
+            continue;
+        if (CardCatalog::isWild(idx)) {
+            for (quint8 c = 0; c < 4; ++c)
+                out.add(qint8(idx), c);
+        } else {
+            out.add(qint8(idx), 0);
+        }
+    }
+    out.add(-1, 0);
+}
+
+bool FastGame::hasPlayableCard() const
+{
+    quint64 hand = hands[current];
+    while (hand) {
+        const int idx = qCountTrailingZeroBits(hand);
+        hand &= hand - 1;
+        if (CardCatalog::isLegal(idx, top, Color(currentColor)))
+            return true;
+    }
+    return false;
+}
+
+//Zufällige passende Karte per Reservoir-Sampling, Extra-Karten mit zufälliger Farbe
+FastMove FastGame::randomPlayout(FastRng& rng) const
+{
+    FastMove move;
+    int seen = 0;
+    quint64 hand = hands[current];
+    while (hand) {
+        const int idx = qCountTrailingZeroBits(hand);
+        hand &= hand - 1;
+        if (!CardCatalog::isLegal(idx, top, Color(currentColor)))
+            continue;
+        ++seen;
+        if (rng.bounded(seen) == 0)
+            move.card = qint8(idx);
+    }
+    if (move.card >= 0 && CardCatalog::isWild(move.card))
+        move.color = quint8(rng.bounded(4));
+    return move;
+}
+
+int FastGame::advance(int steps) const
+{
+    return UnoRules::advanceIndex(current, steps, direction, playerCount);
+}
+
+//Mischt die Ablage (ohne oberste Karte) zurück ins Deck
+void FastGame::refill(FastRng& rng)
+{
+    if (deckSize > 0 || !discardRest)
+        return;
+    quint64 rest = discardRest;
+    while (rest) {
+        deck[deckSize++] = quint8(qCountTrailingZeroBits(rest));
+        rest &= rest - 1;
+    }
+    discardRest = 0;
+    for (int i = deckSize - 1; i > 0; --i) {
+        const int j = rng.bounded(i + 1);
+        qSwap(deck[i], deck[j]);
+    }
+}
+
+int FastGame::drawTo(int player, int count, FastRng& rng)
+{
+    int drawn = 0;
+    for (; drawn < count; ++drawn) {
+        refill(rng);
+        if (deckSize == 0)
+            break;
+        hands[player] |= quint64(1) << deck[--deckSize];
+    }
+    return drawn;
+}
+
+void FastGame::apply(const FastMove& move, FastRng& rng)
+{
+    if (move.card < 0) {
+        // Ziehen beendet den Zug; ist nichts mehr zu ziehen, geht der Zug trotzdem weiter (wie beim Server-Bot)
+        drawTo(current, 1, rng);
+        current = quint8(advance(1));
+        return;
+    }
+
+    const int idx = move.card;
+    hands[current] &= ~(quint64(1) << idx);
+    if (top >= 0)
+        discardRest |= quint64(1) << top;
+    top = qint8(idx);
+
+    const CardCatalog::Card& c = CardCatalog::card(idx);
+    currentColor = c.color == Color::Extra ? move.color : quint8(c.color);
+
+    if (!hands[current]) {
+        winner = qint8(current);
+        return;
+    }
+
+    const UnoRules::PlayEffect effect = UnoRules::effectOf(idx, playerCount);
+    if (effect.reverse)
+        direction = qint8(-direction);
+    if (effect.drawCount > 0)
+        drawTo(advance(1), effect.drawCount, rng);
+    current = quint8(advance(effect.advanceSteps));
+}
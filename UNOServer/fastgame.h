@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include "cardcatalog.h"
+
+// Kompakter, trivial kopierbarer Spielstand für Simulationen (KI-Rollouts).
+// Hände sind Bitmasken über den Kartenindex (46 Karten passen in 64 Bit),
+// das Deck ist ein festes Array. Eine Kopie ist ein memcpy von ~130 Byte.
+
+struct FastMove {
+    qint8 card = -1;                            // -1 = Karte ziehen
+    quint8 color = 0;                           // gewählte Farbe bei Extra-Karten (CardCatalog::Color)
+
+    int key() const { return (card + 1) * 4 + color; }
+    bool operator==(const FastMove& o) const { return card == o.card && color == o.color; }
+};
+
+constexpr int FastMoveKeyCount = (CardCatalog::CardCount + 1) * 4;
+
+struct FastMoveList {
+    FastMove moves[64];
+    int size = 0;
+    void add(qint8 card, quint8 color) { moves[size].card = card; moves[size].color = color; ++size; }
+};
+
+// xorshift64*: schnell, ohne Zustand außerhalb, pro Thread eine Instanz
+struct FastRng {
+    quint64 state;
+    explicit FastRng(quint64 seed) : state(seed ? seed : 0x9E3779B97F4A7C15ull) {}
+    quint64 next()
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1Dull;
+    }
+    int bounded(int n) { return int((next() >> 32) % quint64(n)); }
+};
+
+struct FastGame {
+    static constexpr int MaxPlayers = 7;
+
+    quint64 hands[MaxPlayers] = {};
+    quint8 deck[CardCatalog::CardCount] = {};   // oben = deck[deckSize - 1]
+    quint8 deckSize = 0;
+    quint64 discardRest = 0;                    // Ablage ohne die oberste Karte
+    qint8 top = -1;
+    quint8 currentColor = quint8(CardCatalog::Color::None);
+    quint8 playerCount = 0;
+    quint8 current = 0;
+    qint8 direction = 1;
+    qint8 winner = -1;
+
+    bool finished() const { return winner >= 0; }
+    int handCount(int player) const { return qPopulationCount(hands[player]); }
+
+    // Alle erlaubten Züge des aktuellen Spielers (Extra-Karten je Farbe einmal, Ziehen immer)
+    void legalMoves(FastMoveList& out) const;
+    bool hasPlayableCard() const;
+    // Zufälliger Rollout-Zug: legt eine zufällige passende Karte, sonst wird gezogen
+    FastMove randomPlayout(FastRng& rng) const;
+    // Gleiche Regeln wie Server::playCardForSeat / drawCardsForSeat
+    void apply(const FastMove& move, FastRng& rng);
+
+private:
+    int advance(int steps) const;
+    int drawTo(int player, int count, FastRng& rng);
+    void refill(FastRng& rng);
+};
@@ -0,0 +1,236 @@
+#include "fdhandoff.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QSocketNotifier>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+bool fillAddress(const QString& path, sockaddr_un* addr)
+{
+    const QByteArray native = QFile::encodeName(path);
+    if (native.size() >= int(sizeof(addr->sun_path)))
+        return false;
+    std::memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    std::memcpy(addr->sun_path, native.constData(), size_t(native.size()));
+    return true;
+}
+
+} // namespace
+
+QString FdHandoff::socketPath(const QString& prefix, int workerIndex)
+{
+    return QStringLiteral("%1-%2.sock").arg(prefix).arg(workerIndex);
+}
+
+//Verbindet den Router mit dem Übergabe-Socket eines Workers
+int FdHandoff::connectTo(const QString& path, bool nonBlocking)
+{
+    sockaddr_un addr;
+    if (!fillAddress(path, &addr))
+        return -1;
+    const int fd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | (nonBlocking ? SOCK_NONBLOCK : 0), 0);
+    if (fd < 0)
+        return -1;
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+//Schickt den Deskriptor samt bereits gelesener Bytes in einer einzigen Nachricht
+bool FdHandoff::send(int channel, int fd, const QByteArray& initialBytes)
+{
+    if (initialBytes.size() > MaxPayload)
+        return false;
+    // SEQPACKET braucht mindestens ein Byte Nutzdaten, deshalb ein Versionsbyte vorneweg
+    return sendMessage(channel, QByteArray(1, char(1)) + initialBytes, fd, false);
+}
+
+bool FdHandoff::sendMessage(int channel, const QByteArray& payload, int fd, bool wait)
+{
+    if (channel < 0 || payload.isEmpty())
+        return false;
+
+    iovec iov;
+    iov.iov_base = const_cast<char*>(payload.constData());
+    iov.iov_len = size_t(payload.size());
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    std::memset(control, 0, sizeof(control));
+
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    if (fd >= 0) {
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+
+    ssize_t sent;
+    do {
+        sent = ::sendmsg(channel, &msg, MSG_NOSIGNAL | (wait ? 0 : MSG_DONTWAIT));
+    } while (sent < 0 && errno == EINTR);
+    return sent == ssize_t(payload.size());
+}
+
+//Liest eine Nachricht; payload muss groß genug vorbelegt sein und wird auf die gelesene Länge gekürzt
+int FdHandoff::receiveMessage(int channel, QByteArray* payload, int* fd)
+{
+    *fd = -1;
+    iovec iov;
+    iov.iov_base = payload->data();
+    iov.iov_len = size_t(payload->size());
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t received;
+    do {
+        received = ::recvmsg(channel, &msg, MSG_CMSG_CLOEXEC);
+    } while (received < 0 && errno == EINTR);
+    if (received < 0)
+        return -1;
+
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+            std::memcpy(fd, CMSG_DATA(cmsg), sizeof(int));
+    }
+    if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) {
+        closeFd(*fd);
+        *fd = -1;
+        errno = EMSGSIZE;
+        return -1;
+    }
+    payload->truncate(int(received));
+    return int(received);
+}
+
+int FdHandoff::listenOn(const QString& path)
+{
+    sockaddr_un addr;
+    if (!fillAddress(path, &addr))
+        return -1;
+
+    const int fd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0)
+        return -1;
+    ::unlink(addr.sun_path);
+    // Socket-Datei gleich mit 0600 anlegen: zwischen bind und einem chmod könnte sich sonst jeder verbinden
+    const mode_t oldMask = ::umask(0077);
+    const bool bound = ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    ::umask(oldMask);
+    if (!bound || ::listen(fd, 16) < 0) {
+        qWarning() << "[NET] unix socket" << path << "failed:" << std::strerror(errno);
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void FdHandoff::closeFd(int fd)
+{
+    if (fd >= 0)
+        ::close(fd);
+}
+
+FdHandoffListener::FdHandoffListener(QObject* parent)
+    : QObject(parent)
+{
+}
+
+FdHandoffListener::~FdHandoffListener()
+{
+    for (auto it = m_channels.begin(); it != m_channels.end(); ++it) {
+        delete it.value();
+        ::close(it.key());
+    }
+    delete m_acceptNotifier;
+    if (m_listenFd >= 0) {
+        ::close(m_listenFd);
+        ::unlink(QFile::encodeName(m_path).constData());
+    }
+}
+
+//Legt den Unix-Socket an; ein alter Socket-Pfad (z.B. nach Absturz) wird ersetzt
+bool FdHandoffListener::listen(const QString& path)
+{
+    const int fd = FdHandoff::listenOn(path);
+    if (fd < 0)
+        return false;
+
+    m_path = path;
+    m_listenFd = fd;
+    m_acceptNotifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+    connect(m_acceptNotifier, &QSocketNotifier::activated, this, &FdHandoffListener::onAcceptReady);
+    return true;
+}
+
+void FdHandoffListener::onAcceptReady()
+{
+    while (true) {
+        const int channel = ::accept4(m_listenFd, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+        if (channel < 0)
+            return;
+        auto* notifier = new QSocketNotifier(channel, QSocketNotifier::Read, this);
+        connect(notifier, &QSocketNotifier::activated, this, [this, channel]() { onChannelReady(channel); });
+        m_channels.insert(channel, notifier);
+        qInfo() << "[NET] router attached to handoff socket";
+    }
+}
+
+//Liest alle anstehenden Übergaben; jede Nachricht trägt genau einen Deskriptor
+void FdHandoffListener::onChannelReady(int channel)
+{
+    while (true) {
+        QByteArray payload(1 + FdHandoff::MaxPayload, Qt::Uninitialized);
+        int fd = -1;
+        const int received = FdHandoff::receiveMessage(channel, &payload, &fd);
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return;
+        if (received <= 0) {
+            closeChannel(channel);
+            return;
+        }
+        if (fd < 0)
+            continue;
+        if (payload.at(0) != 1) {
+            ::close(fd);
+            continue;
+        }
+
+        emit connectionReceived(fd, payload.mid(1));
+    }
+}
+
+void FdHandoffListener::closeChannel(int channel)
+{
+    // Läuft im activated-Signal des Notifiers, daher nicht direkt löschen
+    if (QSocketNotifier* notifier = m_channels.take(channel)) {
+        notifier->setEnabled(false);
+        notifier->deleteLater();
+    }
+    ::close(channel);
+    qInfo() << "[NET] router detached from handoff socket";
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QString>
+
+class QSocketNotifier;
+
+// Übergabe offener TCP-Verbindungen zwischen Prozessen (Router -> Worker) per
+// SCM_RIGHTS über einen Unix-SOCK_SEQPACKET-Socket. Eine Nachricht = ein
+// Dateideskriptor plus die Bytes, die der Router schon gelesen hat.
+namespace FdHandoff {
+
+constexpr int MaxPayload = 64 * 1024;
+
+QString socketPath(const QString& prefix, int workerIndex);
+
+int connectTo(const QString& path, bool nonBlocking = false);   // -1 bei Fehler
+int listenOn(const QString& path);              // nicht-blockierend, Modus 0600, alter Socket-Pfad wird ersetzt
+// Blockiert nie: ist der Kanal voll (Worker hängt), false mit errno EAGAIN
+bool send(int channel, int fd, const QByteArray& initialBytes);
+void closeFd(int fd);
+
+// Allgemeine Nachricht mit optionalem Deskriptor (fd < 0 = keiner).
+// receiveMessage: >0 = Bytes gelesen, 0 = Gegenseite zu, -1 = nichts da bzw. Fehler
+bool sendMessage(int channel, const QByteArray& payload, int fd = -1, bool wait = true);
+int receiveMessage(int channel, QByteArray* payload, int* fd);
+
+} // namespace FdHandoff
+
+// Worker-Seite: lauscht auf dem Unix-Socket und meldet jede übergebene Verbindung
+class FdHandoffListener : public QObject {
+    Q_OBJECT
+public:
+    explicit FdHandoffListener(QObject* parent = nullptr);
+    ~FdHandoffListener() override;
+
+    bool listen(const QString& path);
+
+signals:
+    void connectionReceived(qintptr fd, const QByteArray& initialBytes);
+
+private:
+    void onAcceptReady();
+    void onChannelReady(int channel);
+    void closeChannel(int channel);
+
+    QString m_path;
+    int m_listenFd = -1;
+    QSocketNotifier* m_acceptNotifier = nullptr;
+    QHash<int, QSocketNotifier*> m_channels;    // Verbindungen von Routern
+};
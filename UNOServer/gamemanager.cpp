@@ -1,69 +1,80 @@
 #include "gamemanager.h"
 #include "clientconnection.h"
+#include "cardcatalog.h"
 
 #include <QMutexLocker>
-#include <QDir>
-#include <QFileInfoList>
+#include <QReadLocker>
+#include <QWriteLocker>
 #include <QRandomGenerator>
 
-Game* GameManager::getGame(const QString& code)
+//Nachschlagen: nur die Lesesperre eines Shards, parallel zu allen anderen Lesern
+std::shared_ptr<Game> GameManager::getGame(const QString& code) const
 {
-    QMutexLocker lock(&mutex);
-    return games.value(code, nullptr);
+    const Shard& shard = shardFor(code);
+    QReadLocker lock(&shard.lock);
+    return shard.games.value(code);
 }
 
-void GameManager::createGame(const QString& code, ClientConnection* host)
+bool GameManager::createGame(const QString& code, ClientConnection* host)
 {
-    QMutexLocker lock(&mutex);
-
-    if (games.contains(code))
-        return;
-
-    Game* g = new Game();
+    // Spiel außerhalb der Sperre anlegen, der Shard ist nur fürs Einfügen gesperrt
+    auto g = std::make_shared<Game>();
     g->code = code;
     g->host = host;
     g->players.insert(host);
 
-    games.insert(code, g);
+    Shard& shard = shardFor(code);
+    QWriteLocker lock(&shard.lock);
+    if (shard.games.contains(code))
+        return false;
+    shard.games.insert(code, std::move(g));
+    return true;
 }
 
-bool GameManager::addPlayer(const QString& code, ClientConnection* player)
+//Entfernt das Spiel aus dem Register; wer noch einen shared_ptr hält, kann es zu Ende benutzen
+bool GameManager::removeGame(const QString& code)
 {
-    QMutexLocker lock(&mutex);
-
-    Game* g = games.value(code, nullptr);
-    if (!g) return false;
-
-    g->players.insert(player);
-    return true;
+    std::shared_ptr<Game> removed;
+    {
+        Shard& shard = shardFor(code);
+        QWriteLocker lock(&shard.lock);
+        removed = shard.games.take(code);
+    }
+    // Letzte Referenz wird hier nach der Sperre freigegeben, nicht darin
+    return removed != nullptr;
 }
 
-static bool isPngJpg(const QString& name)
+bool GameManager::addPlayer(const QString& code, ClientConnection* player)
 {
-    const QString n = name.toLower();
-    return n.endsWith(".png") || n.endsWith(".jpg") || n.endsWith(".jpeg");
+    return withGame(code, [player](Game& g) {
+        g.players.insert(player);
+    });
 }
 
-QStringList GameManager::loadDeckFromFolder(QString* error) const
+int GameManager::gameCount() const
 {
-    // Erwartet einen Ordner "cards" im Arbeitsverzeichnis des Servers:
-    // UNOServer/build/.../cards/*.png
-    // -> Leg dort deine PNGs rein (oder kopier den cards-Ordner neben die .exe)
-    QDir dir(QDir::currentPath() + "/cards");
-    if (!dir.exists()) {
-        if (error) *error = "Server: cards-Ordner nicht gefunden: " + dir.absolutePath();
-        return {};
+    int count = 0;
+    for (const Shard& shard : m_shards) {
+        QReadLocker lock(&shard.lock);
+        count += int(shard.games.size());
     }
+    return count;
+}
 
-    const QFileInfoList files = dir.entryInfoList(QDir::Files, QDir::Name);
-    QStringList deck;
-    for (const QFileInfo& fi : files) {
-        if (isPngJpg(fi.fileName()))
-            deck.push_back(fi.fileName()); // wir senden nur den Dateinamen an den Client
-    }
+QStringList GameManager::loadDeckFromFolder(QString* error) const
+{
+    // Karten stehen in der beim Build erzeugten Tabelle (cardindex.h), kein cards-Ordner mehr nötig.
+    // Einmal gebaut, danach teilt sich jedes Spiel die Liste bis zum Mischen.
+    static const QStringList deck = [] {
+        QStringList d;
+        d.reserve(CardCatalog::CardCount);
+        for (int i = 0; i < CardCatalog::CardCount; ++i)
+            d.push_back(QString(CardCatalog::name(i))); // wir senden nur den Dateinamen an den Client
+        return d;
+    }();
 
     if (deck.isEmpty()) {
-        if (error) *error = "Server: cards-Ordner ist leer oder keine png/jpg gefunden.";
+        if (error) *error = "Server: Kartentabelle ist leer.";
     }
     return deck;
 }
@@ -79,13 +90,14 @@ void GameManager::shuffle(QStringList& list) const
 
 bool GameManager::startGame(const QString& code, QString* error)
 {
-    QMutexLocker lock(&mutex);
-
-    Game* g = games.value(code, nullptr);
+    const std::shared_ptr<Game> g = getGame(code);
     if (!g) {
         if (error) *error = "Game not found";
         return false;
     }
+
+    // Nur dieses Spiel sperren: andere Spiele und Lookups laufen weiter
+    QMutexLocker lock(&g->mutex);
     if (g->started) {
         if (error) *error = "Game already started";
         return false;
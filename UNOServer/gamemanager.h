@@ -3,8 +3,11 @@
 #include <QHash>
 #include <QSet>
 #include <QMutex>
+#include <QReadWriteLock>
 #include <QStringList>
 
+#include <memory>
+
 class ClientConnection;
 
 struct Game {
@@ -18,23 +21,59 @@ struct Game {
     QStringList deck;        // draw pile (oben = last)
     QStringList discard;     // discard pile (oben = last)
     QHash<ClientConnection*, QStringList> hands; // pro Spieler 6 Karten
+
+    // Schützt alle Felder oben; gehalten nur für die Dauer eines Zugriffs auf dieses Spiel
+    mutable QMutex mutex;
 };
 
+// Register aller Spiele, sicher für mehrere Threads. Die Codes sind auf ShardCount
+// Shards verteilt, jeder mit eigenem QReadWriteLock: Nachschlagen nimmt nur die
+// Lesesperre eines Shards, Anlegen/Entfernen die Schreibsperre eines Shards. Der
+// Spielzustand selbst hängt an Game::mutex, die Shard-Sperre ist dabei nie gehalten.
+// Spiele werden als shared_ptr herausgegeben und bleiben gültig, auch wenn sie
+// währenddessen aus dem Register entfernt werden.
 class GameManager {
 public:
+    static constexpr int ShardCount = 16;       // Zweierpotenz, Shard = Hash & (ShardCount - 1)
+    static_assert((ShardCount & (ShardCount - 1)) == 0, "ShardCount muss eine Zweierpotenz sein");
+
     GameManager() = default;
+    GameManager(const GameManager&) = delete;
+    GameManager& operator=(const GameManager&) = delete;
 
-    Game* getGame(const QString& code);
-    void createGame(const QString& code, ClientConnection* host);
+    std::shared_ptr<Game> getGame(const QString& code) const;
+    bool createGame(const QString& code, ClientConnection* host);   // false = Code schon vergeben
+    bool removeGame(const QString& code);
     bool addPlayer(const QString& code, ClientConnection* player);
+    int gameCount() const;
+
+    // Führt fn(Game&) unter der Sperre des Spiels aus; false, wenn es das Spiel nicht gibt
+    template <typename Fn>
+    bool withGame(const QString& code, Fn&& fn) const
+    {
+        const std::shared_ptr<Game> g = getGame(code);
+        if (!g)
+            return false;
+        QMutexLocker lock(&g->mutex);
+        fn(*g);
+        return true;
+    }
 
     // NEU:
     bool startGame(const QString& code, QString* error);
 
 private:
+    // Auf eigene Cache-Lines, damit Threads auf verschiedenen Shards sich nicht ausbremsen
+    struct alignas(64) Shard {
+        mutable QReadWriteLock lock;
+        QHash<QString, std::shared_ptr<Game>> games;
+    };
+
+    Shard& shardFor(const QString& code) { return m_shards[qHash(code) & (ShardCount - 1)]; }
+    const Shard& shardFor(const QString& code) const { return m_shards[qHash(code) & (ShardCount - 1)]; }
+
     QStringList loadDeckFromFolder(QString* error) const;
     void shuffle(QStringList& list) const;
 
-    QHash<QString, Game*> games;
-    QMutex mutex;
+    Shard m_shards[ShardCount];
 };
@@ -0,0 +1,152 @@
+#include "gamesnapshot.h"
+#include "cardcatalog.h"
+#include "server.h"
+
+#include <QDataStream>
+#include <QIODevice>
+
+namespace {
+
+constexpr int MaxSeats = 16;
+
+enum SeatFlag : quint8 {
+    SeatBot = 0x01,
+    SeatStrongBot = 0x02,
+    SeatAbandoned = 0x04,
+};
+
+enum GameFlag : quint8 {
+    GameStarted = 0x01,
+    GameFinished = 0x02,
+    GameUnoDeclared = 0x04,
+};
+
+QByteArray encodeCards(const QStringList& cards)
+{
+    QByteArray out;
+    out.reserve(cards.size());
+    for (const QString& c : cards)
+        out.append(char(quint8(CardCatalog::indexOf(c))));
+    return out;
+}
+
+bool decodeCards(const QByteArray& data, QStringList* cards)
+{
+    cards->clear();
+    cards->reserve(data.size());
+    for (char c : data) {
+        const int idx = quint8(c);
+        if (idx >= CardCatalog::CardCount)
+            return false;
+        cards->append(QString(CardCatalog::name(idx)));
+    }
+    return true;
+}
+
+} // namespace
+
+QByteArray GameSnapshot::encode(const GameState& g)
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+
+    quint8 flags = 0;
+    if (g.started) flags |= GameStarted;
+    if (g.finished) flags |= GameFinished;
+    if (g.pendingUnoDeclared) flags |= GameUnoDeclared;
+
+    out << Magic << Version
+        << g.code << flags
+        << qint16(g.currentPlayerIndex) << qint8(g.direction)
+        << quint8(CardCatalog::colorFromName(g.currentColor))
+        << qint16(g.pendingUnoPlayerIndex)
+        << encodeCards(g.deck) << encodeCards(g.discard)
+        << quint8(g.seats.size());
+
+    for (const PlayerSeat& seat : g.seats) {
+        quint8 seatFlags = 0;
+        if (seat.bot) seatFlags |= SeatBot;
+        if (seat.strongBot) seatFlags |= SeatStrongBot;
+        if (seat.abandoned) seatFlags |= SeatAbandoned;
+        out << seatFlags << seat.resumeToken << encodeCards(seat.hand);
+    }
+
+    out << g.eventSeq << quint32(g.recentEvents.size());
+    for (const auto& ev : g.recentEvents)
+        out << ev.first << ev.second;
+
+    out << g.logLines;
+    return data;
+}
+
+//Liest einen Snapshot; bei unbekannter Version oder kaputten Daten bleibt game unverändert
+bool GameSnapshot::decode(const QByteArray& data, GameState* game, QString* error)
+{
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != Magic || version != Version) {
+        if (error) *error = "Unsupported snapshot";
+        return false;
+    }
+
+    GameState g;
+    quint8 flags = 0, color = 0, seatCount = 0;
+    qint16 current = 0, pendingUno = -1;
+    qint8 direction = 1;
+    QByteArray deck, discard;
+    in >> g.code >> flags >> current >> direction >> color >> pendingUno >> deck >> discard >> seatCount;
+
+    if (in.status() != QDataStream::Ok || seatCount > MaxSeats || current < 0 || current >= qMax<int>(1, seatCount)
+        || (direction != 1 && direction != -1) || color > quint8(CardCatalog::Color::None)
+        || !decodeCards(deck, &g.deck) || !decodeCards(discard, &g.discard)) {
+        if (error) *error = "Corrupt snapshot";
+        return false;
+    }
+
+    g.started = flags & GameStarted;
+    g.finished = flags & GameFinished;
+    g.pendingUnoDeclared = flags & GameUnoDeclared;
+    g.currentPlayerIndex = current;
+    g.direction = direction;
+    g.currentColor = CardCatalog::Color(color) == CardCatalog::Color::None
+                         ? QString() : QString(CardCatalog::colorName(CardCatalog::Color(color)));
+    g.pendingUnoPlayerIndex = pendingUno;
+
+    for (int i = 0; i < seatCount; ++i) {
+        PlayerSeat seat;
+        quint8 seatFlags = 0;
+        QByteArray hand;
+        in >> seatFlags >> seat.resumeToken >> hand;
+        if (in.status() != QDataStream::Ok || !decodeCards(hand, &seat.hand)) {
+            if (error) *error = "Corrupt snapshot";
+            return false;
+        }
+        seat.bot = seatFlags & SeatBot;
+        seat.strongBot = seatFlags & SeatStrongBot;
+        seat.abandoned = seatFlags & SeatAbandoned;
+        g.seats.append(seat);
+    }
+
+    quint32 eventCount = 0;
+    in >> g.eventSeq >> eventCount;
+    for (quint32 i = 0; i < eventCount && in.status() == QDataStream::Ok; ++i) {
+        quint64 seq = 0;
+        QByteArray payload;
+        in >> seq >> payload;
+        g.recentEvents.append(qMakePair(seq, payload));
+    }
+    in >> g.logLines;
+
+    if (in.status() != QDataStream::Ok) {
+        if (error) *error = "Corrupt snapshot";
+        return false;
+    }
+
+    *game = std::move(g);
+    return true;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+struct GameState;
+
+// Versioniertes Binärformat eines laufenden Spiels für die Migration zwischen
+// Server-Prozessen. Karten werden als Katalog-Index (1 Byte) gespeichert.
+// Nicht enthalten sind Sockets und Zuschauer; alle Spielerplätze kommen
+// beim Empfänger als "getrennt, reserviert" an und werden per resume übernommen.
+namespace GameSnapshot {
+
+constexpr quint32 Magic = 0x554E4F53;           // "UNOS"
+constexpr quint16 Version = 1;
+
+QByteArray encode(const GameState& game);
+bool decode(const QByteArray& data, GameState* game, QString* error);
+
+} // namespace GameSnapshot
@@ -0,0 +1,52 @@
+#include "hashring.h"
+
+#include <QString>
+
+ConsistentHashRing::ConsistentHashRing(int virtualNodes)
+    : m_virtualNodes(qMax(1, virtualNodes))
+{
+}
+
+//FNV-1a über die UTF-16-Codeeinheiten, unabhängig von qHash-Seeds
+quint32 ConsistentHashRing::hash(QStringView key)
+{
+    quint32 h = 2166136261u;
+    for (QChar c : key) {
+        h ^= c.unicode() & 0xff;
+        h *= 16777619u;
+        h ^= c.unicode() >> 8;
+        h *= 16777619u;
+    }
+    // Finalizer, damit ähnliche Schlüssel ("worker-1#2", "worker-1#3") gut streuen
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    return h;
+}
+
+void ConsistentHashRing::addNode(int node)
+{
+    for (int v = 0; v < m_virtualNodes; ++v)
+        m_ring.insert(hash(QStringLiteral("worker-%1#%2").arg(node).arg(v)), node);
+}
+
+void ConsistentHashRing::removeNode(int node)
+{
+    for (auto it = m_ring.begin(); it != m_ring.end();) {
+        if (it.value() == node)
+            it = m_ring.erase(it);
+        else
+            ++it;
+    }
+}
+
+//Erster virtueller Knoten im Uhrzeigersinn ab dem Hash des Schlüssels
+int ConsistentHashRing::nodeFor(QStringView key) const
+{
+    if (m_ring.isEmpty())
+        return -1;
+    auto it = m_ring.lowerBound(hash(key));
+    if (it == m_ring.constEnd())
+        it = m_ring.constBegin();
+    return it.value();
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QMap>
+#include <QStringView>
+
+// Consistent Hashing von Spielcodes auf Worker-Prozesse. Jeder Worker liegt mit
+// mehreren virtuellen Knoten auf dem Ring; kommt ein Worker hinzu oder fällt weg,
+// wandert nur etwa 1/n der Codes. Der Hash (FNV-1a) ist in allen Prozessen gleich.
+class ConsistentHashRing {
+public:
+    explicit ConsistentHashRing(int virtualNodes = 64);
+
+    void addNode(int node);
+    void removeNode(int node);
+    bool isEmpty() const { return m_ring.isEmpty(); }
+
+    // Worker für den Schlüssel, -1 wenn der Ring leer ist
+    int nodeFor(QStringView key) const;
+
+    static quint32 hash(QStringView key);
+
+private:
+    int m_virtualNodes;
+    QMap<quint32, int> m_ring;                  // Position auf dem Ring -> Worker
+};
@@ -0,0 +1,194 @@
+#include "hotrestart.h"
+#include "fdhandoff.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QIODevice>
+#include <QSocketNotifier>
+
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+// Nachrichtenarten auf dem Kontrollsocket (erstes Byte)
+constexpr char KindStateChunk = 'S';
+constexpr char KindStateEnd = 'E';
+constexpr char KindListen = 'L';
+constexpr char KindConnection = 'C';
+constexpr char KindInputChunk = 'B';            // Teil des inBuffer der folgenden Verbindung
+constexpr char KindDone = 'D';
+
+constexpr int ChunkSize = 60 * 1024;
+constexpr int SdListenFdsStart = 3;
+
+QByteArray message(char kind, const QByteArray& body = QByteArray())
+{
+    QByteArray out;
+    out.reserve(1 + body.size());
+    out.append(kind);
+    out.append(body);
+    return out;
+}
+
+} // namespace
+
+//Reihenfolge: Spielstände, Listening-Socket, Verbindungen, Ende. Der Empfänger legt so erst die Spiele an
+bool HotRestart::send(int channel, const State& state)
+{
+    QByteArray blob;
+    {
+        QDataStream out(&blob, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_6_0);
+        out << state.snapshots;
+    }
+    for (int pos = 0; pos < blob.size(); pos += ChunkSize) {
+        if (!FdHandoff::sendMessage(channel, message(KindStateChunk, blob.mid(pos, ChunkSize))))
+            return false;
+    }
+    if (!FdHandoff::sendMessage(channel, message(KindStateEnd)))
+        return false;
+
+    if (state.listenFd >= 0 && !FdHandoff::sendMessage(channel, message(KindListen), state.listenFd))
+        return false;
+
+    // Gepufferte Eingaben in Stücken vorweg (Admin-Verbindungen können Megabytes halten), dann die Verbindung
+    for (const Connection& c : state.connections) {
+        for (int pos = 0; pos < c.inBuffer.size(); pos += ChunkSize) {
+            if (!FdHandoff::sendMessage(channel, message(KindInputChunk, c.inBuffer.mid(pos, ChunkSize))))
+                return false;
+        }
+        QByteArray meta;
+        QDataStream out(&meta, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_6_0);
+        out << c.code << qint32(c.seatIndex) << c.spectator << c.host << c.writeLost;
+        if (!FdHandoff::sendMessage(channel, message(KindConnection, meta), c.fd))
+            return false;
+    }
+
+    return FdHandoff::sendMessage(channel, message(KindDone));
+}
+
+bool HotRestart::receive(const QString& controlPath, int timeoutMs, State* state, QString* error)
+{
+    const int channel = FdHandoff::connectTo(controlPath);
+    if (channel < 0) {
+        if (error) *error = "Cannot connect to " + controlPath;
+        return false;
+    }
+    timeval tv;
+    tv.tv_sec = timeoutMs / 1000;
+    tv.tv_usec = (timeoutMs % 1000) * 1000;
+    ::setsockopt(channel, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    QByteArray blob;
+    QByteArray inBuffer;
+    bool ok = false;
+    while (true) {
+        QByteArray payload(ChunkSize + 1024, Qt::Uninitialized);
+        int fd = -1;
+        if (FdHandoff::receiveMessage(channel, &payload, &fd) <= 0) {
+            if (error) *error = "Control channel closed early";
+            break;
+        }
+
+        const char kind = payload.at(0);
+        const QByteArray body = payload.mid(1);
+        if (kind == KindStateChunk) {
+            blob += body;
+        } else if (kind == KindStateEnd) {
+            QDataStream in(blob);
+            in.setVersion(QDataStream::Qt_6_0);
+            in >> state->snapshots;
+        } else if (kind == KindInputChunk) {
+            inBuffer += body;
+        } else if (kind == KindListen) {
+            state->listenFd = fd;
+        } else if (kind == KindConnection && fd >= 0) {
+            Connection c;
+            c.fd = fd;
+            QDataStream in(body);
+            in.setVersion(QDataStream::Qt_6_0);
+            qint32 seat = -1;
+            in >> c.code >> seat >> c.spectator >> c.host >> c.writeLost;
+            c.seatIndex = seat;
+            c.inBuffer = std::exchange(inBuffer, QByteArray());
+            state->connections.append(c);
+        } else if (kind == KindDone) {
+            ok = true;
+            break;
+        } else {
+            FdHandoff::closeFd(fd);
+        }
+    }
+
+    FdHandoff::closeFd(channel);
+    return ok && state->listenFd >= 0;
+}
+
+//sd_listen_fds() ohne libsystemd: Deskriptoren ab 3, nur wenn LISTEN_PID auf uns zeigt
+int HotRestart::systemdListenFd()
+{
+    bool pidOk = false;
+    const qint64 pid = qEnvironmentVariable("LISTEN_PID").toLongLong(&pidOk);
+    const int count = qEnvironmentVariableIntValue("LISTEN_FDS");
+    if (!pidOk || pid != qint64(::getpid()) || count < 1)
+        return -1;
+
+    qunsetenv("LISTEN_PID");
+    qunsetenv("LISTEN_FDS");
+    qunsetenv("LISTEN_FDNAMES");
+    ::fcntl(SdListenFdsStart, F_SETFD, FD_CLOEXEC);
+    return SdListenFdsStart;
+}
+
+HotRestartListener::HotRestartListener(QObject* parent)
+    : QObject(parent)
+{
+}
+
+HotRestartListener::~HotRestartListener()
+{
+    delete m_notifier;
+    FdHandoff::closeFd(m_listenFd);
+}
+
+//Kontrollsocket nur für den eigenen Benutzer: wer ihn erreicht, bekommt alle Verbindungen.
+//listenOn legt ihn schon mit 0600 an, zusätzlich wird beim Annehmen die Benutzer-ID geprüft
+bool HotRestartListener::listen(const QString& path)
+{
+    m_listenFd = FdHandoff::listenOn(path);
+    if (m_listenFd < 0)
+        return false;
+
+    m_notifier = new QSocketNotifier(m_listenFd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &HotRestartListener::onAcceptReady);
+    return true;
+}
+
+void HotRestartListener::onAcceptReady()
+{
+    // Blockierender Kanal: der alte Prozess schreibt am Ende alles in einem Rutsch
+    const int channel = ::accept4(m_listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (channel < 0)
+        return;
+    ucred peer;
+    socklen_t len = sizeof(peer);
+    if (::getsockopt(channel, SOL_SOCKET, SO_PEERCRED, &peer, &len) < 0 || peer.uid != ::getuid()) {
+        qWarning() << "[NET] hot restart: control connection from foreign user rejected";
+        FdHandoff::closeFd(channel);
+        return;
+    }
+    // Nur eine Übernahme pro Prozess
+    m_notifier->setEnabled(false);
+    emit takeoverRequested(channel);
+}
+
+void HotRestartListener::rearm()
+{
+    if (m_notifier)
+        m_notifier->setEnabled(true);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+class QSocketNotifier;
+
+// Hot-Restart: ein neuer Prozess übernimmt vom alten über einen Unix-Kontrollsocket
+// den Listening-Socket, alle Client-Verbindungen (SCM_RIGHTS) und die Spielstände
+// (GameSnapshot). Clients merken davon nichts, es gibt keinen Reconnect.
+namespace HotRestart {
+
+struct Connection {
+    int fd = -1;
+    QString code;                               // leer = Lobby-Verbindung ohne Spiel
+    int seatIndex = -1;
+    bool spectator = false;
+    bool host = false;
+    QByteArray inBuffer;                        // schon gelesene, noch nicht verarbeitete Bytes
+    bool writeLost = false;                     // Schreibpuffer war nach dem Drain nicht leer und ist verloren
+};
+
+struct State {
+    int listenFd = -1;
+    QList<QByteArray> snapshots;
+    QList<Connection> connections;
+};
+
+// Alter Prozess: schickt alles über den Kanal (blockierend, der Prozess beendet sich danach)
+bool send(int channel, const State& state);
+
+// Neuer Prozess: verbindet sich mit dem Kontrollsocket des alten und empfängt alles
+bool receive(const QString& controlPath, int timeoutMs, State* state, QString* error);
+
+// Systemd-Socket-Aktivierung: übergebener Listening-Socket oder -1
+int systemdListenFd();
+
+} // namespace HotRestart
+
+// Kontrollsocket im laufenden Server; meldet einen neuen Prozess, der übernehmen will
+class HotRestartListener : public QObject {
+    Q_OBJECT
+public:
+    explicit HotRestartListener(QObject* parent = nullptr);
+    ~HotRestartListener() override;
+
+    bool listen(const QString& path);
+    void rearm();                               // nach fehlgeschlagener Übergabe wieder annehmen
+
+signals:
+    void takeoverRequested(int channel);
+
+private:
+    void onAcceptReady();
+
+    int m_listenFd = -1;
+    QSocketNotifier* m_notifier = nullptr;
+};
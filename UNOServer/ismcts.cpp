@@ -0,0 +1,264 @@
+#include "ismcts.h"
+
+#include <QDeadlineTimer>
+#include <QGlobalStatic>
+#include <QMutex>
+#include <QRandomGenerator>
+#include <QThread>
+#include <QThreadPool>
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr quint64 kAllCards = (quint64(1) << CardCatalog::CardCount) - 1;
+
+struct Node {
+    FastMove move;
+    int parent = -1;
+    int firstChild = -1;
+    int nextSibling = -1;
+    qint8 playerJustMoved = -1;
+    quint32 visits = 0;
+    quint32 avails = 1;
+    float wins = 0.0f;
+};
+
+// Bitmenge über Zug-Schlüssel (FastMove::key), um "Zug ist in dieser Determinisierung erlaubt" schnell zu prüfen
+struct MoveKeySet {
+    quint64 bits[(FastMoveKeyCount + 63) / 64] = {};
+    void insert(int key) { bits[key >> 6] |= quint64(1) << (key & 63); }
+    bool contains(int key) const { return bits[key >> 6] & (quint64(1) << (key & 63)); }
+    void remove(int key) { bits[key >> 6] &= ~(quint64(1) << (key & 63)); }
+    bool isEmpty() const
+    {
+        for (quint64 b : bits)
+            if (b) return false;
+        return true;
+    }
+};
+
+struct SharedSearch {
+    QMutex mutex;
+    quint64 visits[FastMoveKeyCount] = {};
+    quint64 iterations = 0;
+    QDeadlineTimer deadline;
+    bool deadlineStarted = false;
+};
+
+// Eigener, auf die Kerne begrenzter Pool: Suchen stauen sich nicht im globalen Pool hinter fremden Tasks
+struct SearchPool : QThreadPool {
+    SearchPool()
+    {
+        setObjectName("IsmctsSearch");
+        setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+    }
+};
+Q_GLOBAL_STATIC(SearchPool, searchPool)
+
+//Budget läuft ab dem Start des ersten Workers, nicht ab dem Einreihen. Später startende Worker
+//teilen sich dieselbe Frist und geben sofort auf, wenn sie schon abgelaufen ist
+QDeadlineTimer startBudget(SharedSearch* shared, int budgetMs)
+{
+    QMutexLocker locker(&shared->mutex);
+    if (!shared->deadlineStarted) {
+        shared->deadline = QDeadlineTimer(budgetMs);
+        shared->deadlineStarted = true;
+    }
+    return shared->deadline;
+}
+
+//Ergebnis eines Rollouts: Gewinner oder, beim Abbruch, der Spieler mit den wenigsten Karten
+int rolloutWinner(FastGame& game, FastRng& rng, int limit)
+{
+    for (int step = 0; step < limit && !game.finished(); ++step)
+        game.apply(game.randomPlayout(rng), rng);
+    if (game.finished())
+        return game.winner;
+
+    int best = 0;
+    for (int p = 1; p < game.playerCount; ++p) {
+        if (game.handCount(p) < game.handCount(best))
+            best = p;
+    }
+    return best;
+}
+
+//Ein Baum, eine Determinisierung pro Iteration, bis die Deadline abläuft
+void runWorker(const IsmctsInfoSet& info, const IsmctsConfig& config, quint64 seed, SharedSearch* shared)
+{
+    const QDeadlineTimer deadline = startBudget(shared, config.budgetMs);
+    if (deadline.hasExpired())
+        return;
+
+    FastRng rng(seed);
+    std::vector<Node> nodes;
+    nodes.reserve(size_t(config.maxNodes));
+    nodes.emplace_back();
+
+    FastMoveList legal;
+    quint64 iterations = 0;
+
+    // Uhr nur alle 64 Iterationen abfragen
+    while ((iterations & 63) || !deadline.hasExpired()) {
+        ++iterations;
+        FastGame game = info.determinize(rng);
+        int node = 0;
+
+        // Auswahl: nur Kinder, deren Zug in dieser Determinisierung erlaubt ist
+        MoveKeySet untried;
+        for (;;) {
+            if (game.finished())
+                break;
+            game.legalMoves(legal);
+            untried = MoveKeySet();
+            for (int i = 0; i < legal.size; ++i)
+                untried.insert(legal.moves[i].key());
+
+            int best = -1;
+            double bestScore = -1.0;
+            for (int c = nodes[node].firstChild; c >= 0; c = nodes[c].nextSibling) {
+                const int key = nodes[c].move.key();
+                if (!untried.contains(key))
+                    continue;
+                untried.remove(key);
+                Node& child = nodes[c];
+                ++child.avails;
+                const double score = child.wins / child.visits
+                                     + config.exploration * std::sqrt(std::log(double(child.avails)) / child.visits);
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = c;
+                }
+            }
+
+            if (!untried.isEmpty() || best < 0)
+                break;
+            game.apply(nodes[best].move, rng);
+            node = best;
+        }
+
+        // Erweiterung um einen zufälligen, noch nicht probierten Zug
+        if (!game.finished() && !untried.isEmpty() && int(nodes.size()) < config.maxNodes) {
+            int candidates = 0;
+            FastMove pick;
+            for (int i = 0; i < legal.size; ++i) {
+                if (untried.contains(legal.moves[i].key()) && rng.bounded(++candidates) == 0)
+                    pick = legal.moves[i];
+            }
+            Node child;
+            child.move = pick;
+            child.parent = node;
+            child.playerJustMoved = qint8(game.current);
+            child.nextSibling = nodes[node].firstChild;
+            game.apply(pick, rng);
+            nodes.push_back(child);
+            node = int(nodes.size()) - 1;
+            nodes[child.parent].firstChild = node;
+        }
+
+        const int winner = rolloutWinner(game, rng, config.rolloutLimit);
+
+        for (int n = node; n >= 0; n = nodes[n].parent) {
+            Node& cur = nodes[n];
+            ++cur.visits;
+            if (cur.playerJustMoved == winner)
+                cur.wins += 1.0f;
+        }
+    }
+
+    QMutexLocker locker(&shared->mutex);
+    for (int c = nodes[0].firstChild; c >= 0; c = nodes[c].nextSibling)
+        shared->visits[nodes[c].move.key()] += nodes[c].visits;
+    shared->iterations += iterations;
+}
+
+//Meistbesuchter Wurzelzug über alle Bäume; ohne Daten wird gezogen
+IsmctsResult bestMove(const SharedSearch& shared)
+{
+    IsmctsResult result;
+    result.iterations = shared.iterations;
+    quint64 bestVisits = 0;
+    for (int key = 0; key < FastMoveKeyCount; ++key) {
+        if (shared.visits[key] > bestVisits) {
+            bestVisits = shared.visits[key];
+            result.move.card = qint8(key / 4 - 1);
+            result.move.color = quint8(key % 4);
+        }
+    }
+    return result;
+}
+
+int threadCount(const IsmctsConfig& config)
+{
+    return qMax(1, config.threads > 0 ? config.threads : QThread::idealThreadCount());
+}
+
+} // namespace
+
+FastGame IsmctsInfoSet::determinize(FastRng& rng) const
+{
+    FastGame game;
+    game.playerCount = quint8(playerCount);
+    game.current = quint8(current);
+    game.direction = qint8(direction);
+    game.top = qint8(top);
+    game.currentColor = quint8(currentColor);
+    game.discardRest = discardRest;
+    game.hands[observer] = ownHand;
+
+    quint64 known = ownHand | discardRest;
+    if (top >= 0)
+        known |= quint64(1) << top;
+    quint64 unknown = kAllCards & ~known;
+
+    quint8 pool[CardCatalog::CardCount];
+    int poolSize = 0;
+    while (unknown) {
+        pool[poolSize++] = quint8(qCountTrailingZeroBits(unknown));
+        unknown &= unknown - 1;
+    }
+    for (int i = poolSize - 1; i > 0; --i) {
+        const int j = rng.bounded(i + 1);
+        qSwap(pool[i], pool[j]);
+    }
+
+    int next = 0;
+    for (int p = 0; p < playerCount; ++p) {
+        if (p == observer)
+            continue;
+        for (int k = 0; k < handCounts[p] && next < poolSize; ++k)
+            game.hands[p] |= quint64(1) << pool[next++];
+    }
+    while (next < poolSize)
+        game.deck[game.deckSize++] = pool[next++];
+    return game;
+}
+
+void IsmctsSearch::searchAsync(const IsmctsInfoSet& info, const IsmctsConfig& config,
+                               QObject* context, std::function<void(const IsmctsResult&)> done)
+{
+    auto shared = std::make_shared<SharedSearch>();
+    auto remaining = std::make_shared<std::atomic<int>>(threadCount(config));
+    const int threads = remaining->load();
+    QPointer<QObject> target(context);
+
+    for (int i = 0; i < threads; ++i) {
+        const quint64 seed = QRandomGenerator::global()->generate64();
+        searchPool()->start([=]() {
+            runWorker(info, config, seed, shared.get());
+            // Der letzte Worker liefert das zusammengeführte Ergebnis an den Zielthread
+            if (remaining->fetch_sub(1) != 1)
+                return;
+            const IsmctsResult result = bestMove(*shared);
+            if (!target)
+                return;
+            QMetaObject::invokeMethod(target, [target, done, result]() {
+                if (target) done(result);
+            }, Qt::QueuedConnection);
+        });
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+
+#include <functional>
+
+#include "fastgame.h"
+
+// Sicht eines Spielers auf den Tisch: nur Informationen, die er auch wirklich hat
+// (eigene Hand, Ablage, Kartenzahlen der Gegner). Daraus werden Determinisierungen gezogen.
+struct IsmctsInfoSet {
+    int observer = 0;
+    int playerCount = 0;
+    int current = 0;
+    int direction = 1;
+    quint64 ownHand = 0;
+    quint64 discardRest = 0;                    // Ablage ohne die oberste Karte
+    int top = -1;
+    CardCatalog::Color currentColor = CardCatalog::Color::None;
+    int handCounts[FastGame::MaxPlayers] = {};
+
+    // Verteilt die unbekannten Karten zufällig auf Gegnerhände und Deck
+    FastGame determinize(FastRng& rng) const;
+};
+
+struct IsmctsConfig {
+    int budgetMs = 200;                         // Rechenzeit pro Zug, ab Start des ersten Workers
+    int threads = 2;                            // Bäume pro Suche, 0 = QThread::idealThreadCount()
+    int maxNodes = 1 << 16;                     // Knoten pro Baum, wird einmal vorab reserviert
+    int rolloutLimit = 400;                     // Züge pro Rollout, danach gewinnt die kleinste Hand
+    double exploration = 0.7;
+};
+
+struct IsmctsResult {
+    FastMove move;
+    quint64 iterations = 0;
+};
+
+// Single-Observer-ISMCTS mit Root-Parallelisierung: jeder Thread baut einen eigenen Baum,
+// am Ende werden die Besuchszahlen der Wurzelzüge addiert. Die Suche läuft in einem eigenen,
+// auf die Kerne begrenzten QThreadPool und blockiert die Event-Loop des Servers nie.
+class IsmctsSearch {
+public:
+    // Startet die Suche im Pool und ruft done im Thread von context auf (queued).
+    // Wird context vorher gelöscht, verfällt das Ergebnis.
+    static void searchAsync(const IsmctsInfoSet& info, const IsmctsConfig& config,
+                            QObject* context, std::function<void(const IsmctsResult&)> done);
+};
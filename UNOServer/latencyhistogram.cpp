@@ -0,0 +1,67 @@
+#include "latencyhistogram.h"
+
+#include <QJsonArray>
+
+namespace {
+constexpr qint64 Bounds[LatencyHistogram::BucketCount - 1] = {
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000
+};
+
+double toMs(qint64 us)
+{
+    return us < 0 ? -1.0 : us / 1000.0;
+}
+} // namespace
+
+qint64 LatencyHistogram::upperBoundUs(int bucket)
+{
+    return bucket < BucketCount - 1 ? Bounds[bucket] : -1;
+}
+
+void LatencyHistogram::add(qint64 us)
+{
+    us = qMax<qint64>(0, us);
+    int bucket = 0;
+    while (bucket < BucketCount - 1 && us > Bounds[bucket])
+        ++bucket;
+    ++m_buckets[bucket];
+    ++m_count;
+    m_sumUs += us;
+    m_maxUs = qMax(m_maxUs, us);
+}
+
+//Obergrenze des Buckets, in dem das q-Quantil liegt (im Überlauf-Bucket das Maximum)
+qint64 LatencyHistogram::percentileUs(double q) const
+{
+    if (m_count == 0)
+        return -1;
+    const quint64 rank = quint64(qMax(1.0, q * double(m_count) + 0.5));
+    quint64 seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank)
+            return i < BucketCount - 1 ? qMin(Bounds[i], m_maxUs) : m_maxUs;
+    }
+    return m_maxUs;
+}
+
+QJsonObject LatencyHistogram::toJson() const
+{
+    QJsonArray buckets;
+    for (int i = 0; i < BucketCount; ++i) {
+        const qint64 bound = upperBoundUs(i);
+        buckets.append(QJsonObject{
+            {"leMs", bound < 0 ? QJsonValue("inf") : QJsonValue(toMs(bound))},
+            {"count", double(m_buckets[i])}
+        });
+    }
+    return QJsonObject{
+        {"count", double(m_count)},
+        {"meanMs", m_count ? toMs(m_sumUs / qint64(m_count)) : -1.0},
+        {"p50Ms", toMs(percentileUs(0.50))},
+        {"p95Ms", toMs(percentileUs(0.95))},
+        {"p99Ms", toMs(percentileUs(0.99))},
+        {"maxMs", m_count ? toMs(m_maxUs) : -1.0},
+        {"buckets", buckets}
+    };
+}
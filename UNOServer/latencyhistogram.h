@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QtGlobal>
+
+#include <array>
+
+// Feste Buckets von 100 µs bis 1 s (plus Überlauf) für Laufzeiten wie RTT oder
+// Verarbeitungszeit. Kein Heap, konstanter Speicher, Perzentile auf Bucket-Genauigkeit.
+class LatencyHistogram {
+public:
+    static constexpr int BucketCount = 14;
+
+    void add(qint64 us);
+    quint64 count() const { return m_count; }
+    qint64 percentileUs(double q) const;         // -1 = noch keine Werte
+    QJsonObject toJson() const;
+
+    static qint64 upperBoundUs(int bucket);      // letzter Bucket: unbegrenzt (-1)
+
+private:
+    std::array<quint64, BucketCount> m_buckets{};
+    quint64 m_count = 0;
+    qint64 m_sumUs = 0;
+    qint64 m_maxUs = 0;
+};
@@ -1,10 +1,85 @@
 #include <QCoreApplication>
+#include <QCommandLineParser>
+#include "router.h"
 #include "server.h"
 
 int main(int argc, char *argv[])
 {
     QCoreApplication a(argc, argv);
+
+    //Liest die Server-Einstellungen von der Kommandozeile, ohne Angabe gelten die Defaults aus ServerConfig
+    ServerConfig config;
+    QCommandLineParser parser;
+    parser.setApplicationDescription("UNO Server");
+    parser.addHelpOption();
+
+    QCommandLineOption portOpt("port", "TCP-Port", "port", QString::number(config.port));
+    QCommandLineOption msgRateOpt("msg-rate", "Nachrichten pro Sekunde je Verbindung (0 = unbegrenzt)",
+                                  "n", QString::number(config.msgRatePerConnection));
+    QCommandLineOption msgBurstOpt("msg-burst", "Burst je Verbindung", "n", QString::number(config.msgBurstPerConnection));
+    QCommandLineOption ipRateOpt("ip-rate", "Nachrichten pro Sekunde je IP (0 = unbegrenzt)",
+                                 "n", QString::number(config.msgRatePerIp));
+    QCommandLineOption ipBurstOpt("ip-burst", "Burst je IP", "n", QString::number(config.msgBurstPerIp));
+    QCommandLineOption spectatorDelayOpt("spectator-delay", "Verzögerung des Zuschauer-Streams in ms",
+                                         "ms", QString::number(config.spectatorDelayMs));
+    QCommandLineOption botDelayOpt("bot-delay", "Wartezeit vor einem Bot-Zug in ms",
+                                   "ms", QString::number(config.botMoveDelayMs));
+    QCommandLineOption strongBudgetOpt("strong-bot-budget", "Rechenzeit eines starken Bots pro Zug in ms",
+                                       "ms", QString::number(config.strongBotBudgetMs));
+    QCommandLineOption strongThreadsOpt("strong-bot-threads", "Threads für die Suche starker Bots (0 = alle Kerne)",
+                                        "n", QString::number(config.strongBotThreads));
+    QCommandLineOption pingIntervalOpt("ping-interval", "Abstand der Latenz-Pings in ms (0 = aus)",
+                                       "ms", QString::number(config.pingIntervalMs));
+    QCommandLineOption routerOpt("router", "Nur Router: Verbindungen an die Worker-Prozesse weiterreichen");
+    QCommandLineOption workersOpt("workers", "Anzahl Worker-Prozesse hinter dem Router",
+                                  "n", QString::number(config.workerCount));
+    QCommandLineOption workerIndexOpt("worker-index", "Als Worker Nr. n hinter dem Router laufen", "n");
+    QCommandLineOption workerSocketOpt("worker-socket", "Pfad-Prefix der Übergabe-Sockets",
+                                       "path", config.workerSocketPrefix);
+    QCommandLineOption adminTokenOpt("admin-token", "Token für Admin-Befehle wie migrate_game (leer = aus)", "token");
+    QCommandLineOption controlSocketOpt("control-socket", "Kontrollsocket für Hot-Restart (leer = aus)", "path");
+    QCommandLineOption takeoverOpt("takeover", "Beim Start Verbindungen und Spiele vom laufenden Server übernehmen",
+                                   "control-socket");
+    parser.addOptions({controlSocketOpt, takeoverOpt, adminTokenOpt, portOpt, msgRateOpt, msgBurstOpt, ipRateOpt, ipBurstOpt, spectatorDelayOpt, botDelayOpt,
+                       strongBudgetOpt, strongThreadsOpt, pingIntervalOpt, routerOpt, workersOpt, workerIndexOpt, workerSocketOpt});
+    parser.process(a);
+
+    config.port = parser.value(portOpt).toUShort();
+    config.msgRatePerConnection = parser.value(msgRateOpt).toDouble();
+    config.msgBurstPerConnection = parser.value(msgBurstOpt).toDouble();
+    config.msgRatePerIp = parser.value(ipRateOpt).toDouble();
+    config.msgBurstPerIp = parser.value(ipBurstOpt).toDouble();
+    config.spectatorDelayMs = parser.value(spectatorDelayOpt).toInt();
+    config.botMoveDelayMs = parser.value(botDelayOpt).toInt();
+    config.strongBotBudgetMs = parser.value(strongBudgetOpt).toInt();
+    config.strongBotThreads = parser.value(strongThreadsOpt).toInt();
+    config.pingIntervalMs = parser.value(pingIntervalOpt).toInt();
+    config.adminToken = parser.value(adminTokenOpt);
+    config.controlSocket = parser.value(controlSocketOpt);
+    config.takeoverFrom = parser.value(takeoverOpt);
+    config.workerCount = parser.value(workersOpt).toInt();
+    config.workerSocketPrefix = parser.value(workerSocketOpt);
+    if (parser.isSet(workerIndexOpt))
+        config.workerIndex = parser.value(workerIndexOpt).toInt();
+
+    if ((parser.isSet(routerOpt) || config.workerIndex >= 0)
+        && (config.workerCount <= 0 || config.workerIndex >= config.workerCount)) {
+        qCritical("--router und --worker-index brauchen --workers n (und einen Index kleiner n)");
+        return 1;
+    }
+    // Hot-Restart gibt es nur für einen eigenständigen Server; Router und Worker würden die Optionen ignorieren
+    if ((parser.isSet(routerOpt) || config.workerIndex >= 0)
+        && (!config.controlSocket.isEmpty() || !config.takeoverFrom.isEmpty())) {
+        qCritical("--control-socket und --takeover gehen nicht zusammen mit --router oder --worker-index");
+        return 1;
+    }
+
+    if (parser.isSet(routerOpt)) {
+        Router router(config);
+        return a.exec();
+    }
+
     //Instanziert den Server und Führt die App aus
-    Server server;
+    Server server(config);
     return a.exec();
 }
@@ -0,0 +1,89 @@
+#include "matchmaker.h"
+
+Matchmaker::Matchmaker(int ratingBucketWidth)
+    : m_ratingBucketWidth(qMax(1, ratingBucketWidth))
+{
+}
+
+//Tischgröße in den oberen 32 Bit, Rating-Bereich in den unteren (0 = ohne Rating)
+quint64 Matchmaker::bucketKey(int tableSize, int rating) const
+{
+    const quint32 ratingBucket = rating < 0 ? 0u : quint32(rating / m_ratingBucketWidth) + 1u;
+    return (quint64(quint32(tableSize)) << 32) | ratingBucket;
+}
+
+//Reiht einen Spieler ein, false wenn er schon wartet
+bool Matchmaker::enqueue(QTcpSocket* sock, int tableSize, int rating)
+{
+    if (!sock || tableSize < 2 || m_tickets.contains(sock))
+        return false;
+
+    Ticket t;
+    t.bucket = bucketKey(tableSize, rating);
+    t.seq = m_nextSeq++;
+
+    QMap<quint64, QTcpSocket*>& queue = m_buckets[t.bucket];
+    queue.insert(t.seq, sock);
+    m_tickets.insert(sock, t);
+
+    if (queue.size() >= tableSize)
+        m_readyBuckets.insert(t.bucket);
+    return true;
+}
+
+//Nimmt einen Spieler wieder aus der Warteschlange (Abbruch oder Disconnect)
+bool Matchmaker::remove(QTcpSocket* sock)
+{
+    auto it = m_tickets.find(sock);
+    if (it == m_tickets.end())
+        return false;
+
+    const Ticket t = it.value();
+    m_tickets.erase(it);
+
+    auto bucketIt = m_buckets.find(t.bucket);
+    if (bucketIt == m_buckets.end())
+        return true;
+
+    bucketIt->remove(t.seq);
+    if (bucketIt->size() < tableSizeOf(t.bucket))
+        m_readyBuckets.remove(t.bucket);
+    if (bucketIt->isEmpty())
+        m_buckets.erase(bucketIt);
+    return true;
+}
+
+//Nimmt aus jedem vollen Bucket die am längsten Wartenden und bildet daraus Tische
+QList<QList<QTcpSocket*>> Matchmaker::formTables(int maxTables)
+{
+    QList<QList<QTcpSocket*>> tables;
+
+    auto readyIt = m_readyBuckets.begin();
+    while (readyIt != m_readyBuckets.end() && tables.size() < maxTables) {
+        const quint64 bucket = *readyIt;
+        const int size = tableSizeOf(bucket);
+        QMap<quint64, QTcpSocket*>& queue = m_buckets[bucket];
+
+        while (queue.size() >= size && tables.size() < maxTables) {
+            QList<QTcpSocket*> table;
+            table.reserve(size);
+            for (int i = 0; i < size; ++i) {
+                auto first = queue.begin();
+                table.append(first.value());
+                m_tickets.remove(first.value());
+                queue.erase(first);
+            }
+            tables.append(table);
+        }
+
+        const int remaining = queue.size();
+        if (remaining == 0)
+            m_buckets.remove(bucket);
+
+        if (remaining < size)
+            readyIt = m_readyBuckets.erase(readyIt);
+        else
+            ++readyIt;
+    }
+    return tables;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QSet>
+
+class QTcpSocket;
+
+// Warteschlange für automatische Tische. Spieler landen in einem Bucket je
+// (Tischgröße, Rating-Bereich); innerhalb eines Buckets gilt FIFO.
+// Einreihen und Entfernen sind O(log n), ein Tisch kostet O(size * log n).
+class Matchmaker {
+public:
+    static constexpr int NoRating = -1;
+
+    explicit Matchmaker(int ratingBucketWidth = 200);
+
+    bool enqueue(QTcpSocket* sock, int tableSize, int rating = NoRating);
+    bool remove(QTcpSocket* sock);
+    bool contains(QTcpSocket* sock) const { return m_tickets.contains(sock); }
+    int queuedCount() const { return m_tickets.size(); }
+    bool hasReadyTables() const { return !m_readyBuckets.isEmpty(); }
+
+    // Bildet höchstens maxTables volle Tische aus den Buckets, die genug Spieler haben
+    QList<QList<QTcpSocket*>> formTables(int maxTables);
+
+private:
+    struct Ticket {
+        quint64 bucket = 0;
+        quint64 seq = 0;
+    };
+
+    quint64 bucketKey(int tableSize, int rating) const;
+    static int tableSizeOf(quint64 bucket) { return int(bucket >> 32); }
+
+    int m_ratingBucketWidth;
+    quint64 m_nextSeq = 0;
+    QHash<quint64, QMap<quint64, QTcpSocket*>> m_buckets;   // Bucket -> (Einreihungsnummer -> Spieler)
+    QHash<QTcpSocket*, Ticket> m_tickets;
+    QSet<quint64> m_readyBuckets;                           // Buckets mit mindestens einem vollen Tisch
+};
@@ -0,0 +1,161 @@
+#include "router.h"
+#include "fdhandoff.h"
+
+#include <QJsonDocument>
+#include <QTcpSocket>
+#include <cerrno>
+#include <utility>
+
+Router::Router(const ServerConfig& config, QObject* parent)
+    : QObject(parent), m_config(config), m_ring(config.ringVirtualNodes)
+{
+    for (int i = 0; i < m_config.workerCount; ++i) {
+        m_ring.addNode(i);
+        m_channels.append(-1);
+    }
+
+    connect(&m_server, &QTcpServer::newConnection, this, &Router::onNewConnection);
+    connect(&m_housekeepingTimer, &QTimer::timeout, this, &Router::dropStalePending);
+    m_housekeepingTimer.start(1000);
+    m_clock.start();
+
+    const quint16 port = m_config.port;
+    if (!m_server.listen(QHostAddress::Any, port)) {
+        qFatal("Router listen failed");
+    }
+    qInfo() << "[NET] Router listening on port" << port << "for" << m_config.workerCount << "workers";
+}
+
+Router::~Router()
+{
+    for (int channel : std::as_const(m_channels))
+        FdHandoff::closeFd(channel);
+}
+
+void Router::onNewConnection()
+{
+    while (m_server.hasPendingConnections()) {
+        QTcpSocket* sock = m_server.nextPendingConnection();
+        sock->setReadBufferSize(m_config.maxFrameSize + 1);
+
+        PendingConnection pending;
+        pending.acceptedAtMs = m_clock.elapsed();
+        m_pending.insert(sock, pending);
+
+        connect(sock, &QTcpSocket::readyRead, this, [this, sock]() { onReadyRead(sock); });
+        connect(sock, &QTcpSocket::disconnected, this, [this, sock]() {
+            m_pending.remove(sock);
+            sock->deleteLater();
+        });
+    }
+}
+
+//Sammelt Bytes bis zur ersten vollständigen Zeile und reicht dann weiter
+void Router::onReadyRead(QTcpSocket* sock)
+{
+    auto it = m_pending.find(sock);
+    if (it == m_pending.end())
+        return;
+
+    it->buffer += sock->readAll();
+    const int nl = it->buffer.indexOf('\n');
+    if (nl < 0) {
+        if (it->buffer.size() > m_config.maxFrameSize)
+            reject(sock, "Frame too large");
+        return;
+    }
+    if (nl > m_config.maxFrameSize) {
+        reject(sock, "Frame too large");
+        return;
+    }
+
+    // Ungültiges JSON geht trotzdem an einen Worker, der antwortet wie immer mit "Invalid JSON"
+    const QJsonObject first = QJsonDocument::fromJson(it->buffer.left(nl).trimmed()).object();
+    const QByteArray bytes = it->buffer;
+    m_pending.erase(it);
+    handOff(sock, workerFor(first), bytes);
+}
+
+//Worker für die erste Nachricht: Code bzw. Token-Präfix über den Ring, sonst reihum
+int Router::workerFor(const QJsonObject& msg)
+{
+    const QString type = msg.value("type").toString();
+
+    QString code;
+    if (type == "resume")
+        code = msg.value("token").toString().section('.', 0, 0);
+    else if (msg.contains("code"))
+        code = msg.value("code").toString().trimmed().toUpper();
+
+    if (!code.isEmpty())
+        return m_ring.nodeFor(code);
+
+    // Warteschlangen je Tischgröße liegen komplett auf einem Worker, sonst würden sie zersplittern
+    if (type == "queue_join")
+        return m_ring.nodeFor(QStringLiteral("queue:%1").arg(msg.value("size").toInt(2)));
+
+    // create_game & Co.: der Worker vergibt selbst einen Code, der auf ihn zeigt
+    return int(m_roundRobin++ % quint64(qMax(1, m_config.workerCount)));
+}
+
+//Übergabe-Socket zum Worker, bei Bedarf (neu) verbunden, z.B. nach einem Worker-Neustart
+int Router::channelFor(int worker, bool reconnect)
+{
+    if (worker < 0 || worker >= m_channels.size())
+        return -1;
+    int& channel = m_channels[worker];
+    if (reconnect && channel >= 0) {
+        FdHandoff::closeFd(channel);
+        channel = -1;
+    }
+    if (channel < 0)
+        channel = FdHandoff::connectTo(FdHandoff::socketPath(m_config.workerSocketPrefix, worker), true);
+    return channel;
+}
+
+void Router::handOff(QTcpSocket* sock, int worker, const QByteArray& bytes)
+{
+    // Nicht-blockierend: ein hängender Worker darf das Annehmen neuer Verbindungen nicht aufhalten
+    const int fd = int(sock->socketDescriptor());
+    bool sent = FdHandoff::send(channelFor(worker, false), fd, bytes);
+    if (!sent && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        qWarning() << "[NET] worker" << worker << "busy";
+        reject(sock, "Game server busy");
+        return;
+    }
+    if (!sent)
+        sent = FdHandoff::send(channelFor(worker, true), fd, bytes);
+    if (!sent) {
+        qWarning() << "[NET] worker" << worker << "unavailable";
+        reject(sock, "Game server unavailable");
+        return;
+    }
+
+    // Der Worker hält jetzt eine eigene Referenz; unser close() beendet die TCP-Verbindung nicht
+    disconnect(sock, nullptr, this, nullptr);
+    sock->abort();
+    sock->deleteLater();
+}
+
+void Router::reject(QTcpSocket* sock, const QString& message)
+{
+    m_pending.remove(sock);
+    disconnect(sock, &QTcpSocket::readyRead, this, nullptr);
+    sock->write(QJsonDocument(QJsonObject{{"type","error"},{"message",message}}).toJson(QJsonDocument::Compact) + "\n");
+    sock->disconnectFromHost();
+}
+
+//Verbindungen, die nie eine erste Nachricht schicken, belegen sonst dauerhaft Deskriptoren
+void Router::dropStalePending()
+{
+    const qint64 now = m_clock.elapsed();
+    QList<QTcpSocket*> stale;
+    for (auto it = m_pending.cbegin(); it != m_pending.cend(); ++it) {
+        if (now - it->acceptedAtMs > m_config.routerFirstMessageTimeoutMs)
+            stale.append(it.key());
+    }
+    for (QTcpSocket* sock : std::as_const(stale)) {
+        m_pending.remove(sock);
+        sock->abort();
+    }
+}
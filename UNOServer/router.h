@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QTcpServer>
+#include <QTimer>
+
+#include "hashring.h"
+#include "serverconfig.h"
+
+class QTcpSocket;
+
+// Vorgeschalteter Router für mehrere Worker-Prozesse. Er liest nur die erste
+// Nachricht einer Verbindung, bestimmt daraus den zuständigen Worker und reicht
+// den Socket samt gelesener Bytes per fd-Übergabe weiter. Danach ist der Router
+// aus dem Datenpfad raus; Spielzustand hält er keinen. Nennt eine spätere Nachricht
+// derselben Verbindung einen Code eines anderen Workers, leitet der Worker den Client
+// per "redirect" zurück an den Router (siehe Server::redirectIfForeign).
+class Router : public QObject {
+    Q_OBJECT
+public:
+    explicit Router(const ServerConfig& config, QObject* parent = nullptr);
+    ~Router() override;
+
+private:
+    struct PendingConnection {
+        QByteArray buffer;
+        qint64 acceptedAtMs = 0;
+    };
+
+    void onNewConnection();
+    void onReadyRead(QTcpSocket* sock);
+    void dropStalePending();
+    int workerFor(const QJsonObject& msg);
+    int channelFor(int worker, bool reconnect);
+    void handOff(QTcpSocket* sock, int worker, const QByteArray& bytes);
+    void reject(QTcpSocket* sock, const QString& message);
+
+    ServerConfig m_config;
+    QTcpServer m_server;
+    QTimer m_housekeepingTimer;
+    QElapsedTimer m_clock;
+    ConsistentHashRing m_ring;
+    QList<int> m_channels;                      // Übergabe-Socket je Worker, -1 = nicht verbunden
+    QHash<QTcpSocket*, PendingConnection> m_pending;
+    quint64 m_roundRobin = 0;
+};
@@ -1,54 +1,111 @@
 #include "server.h"
+#include "botplayer.h"
+#include "cardcatalog.h"
+#include "rules.h"
+#include "gamesnapshot.h"
 
+#include <QCoreApplication>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <QPointer>
 #include <QRandomGenerator>
 #include <QDateTime>
+#include <utility>
 
 namespace {
 
-struct CardInfo {
-    QString color;
-    QString value;
-    bool isWild = false;
-};
-
-//Liest die Info aus den Kartennummern aus, z.B. "Blau" und setzt diese in die CardInfo struktur ein.
-CardInfo parseCardInfo(const QString& cardName)
+QByteArray encodeJson(const QJsonObject& obj)
 {
-    QString base = cardName;
-    const int dot = base.lastIndexOf('.');
-    if (dot >= 0)
-        base = base.left(dot);
-
-    const QStringList parts = base.split('_');
-    CardInfo info;
-    if (parts.isEmpty())
-        return info;
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact) + "\n";
+}
 
-    if (parts.first() == "Extra") {
-        info.isWild = true;
-        info.color = "Extra";
-        info.value = parts.mid(1).join("_");
-        return info;
+quint64 handMask(const QStringList& cards)
+{
+    quint64 mask = 0;
+    for (const QString& c : cards) {
+        const int idx = CardCatalog::indexOf(c);
+        if (idx >= 0)
+            mask |= quint64(1) << idx;
     }
+    return mask;
+}
 
-    info.color = parts.value(0);
-    info.value = parts.mid(1).join("_");
+//Sicht eines Bot-Platzes für die Suche: eigene Hand, Ablage und nur die Kartenzahlen der anderen
+IsmctsInfoSet infoSetFor(const GameState& g, int seatIndex)
+{
+    IsmctsInfoSet info;
+    info.observer = seatIndex;
+    info.playerCount = qMin(int(g.seats.size()), FastGame::MaxPlayers);
+    info.current = g.currentPlayerIndex;
+    info.direction = g.direction;
+    info.ownHand = handMask(g.seats[seatIndex].hand);
+    if (!g.discard.isEmpty()) {
+        info.top = CardCatalog::indexOf(g.discard.last());
+        info.discardRest = handMask(g.discard) & ~(info.top >= 0 ? quint64(1) << info.top : 0);
+    }
+    info.currentColor = CardCatalog::colorFromName(g.currentColor);
+    for (int i = 0; i < info.playerCount; ++i)
+        info.handCounts[i] = g.seats[i].hand.size();
     return info;
 }
 } // namespace
 
 //Hauptfunktion des Servers, startet die Verbindungsannahme und gibt ein Debug aus
-Server::Server(QObject* parent) : QObject(parent)
+Server::Server(const ServerConfig& config, QObject* parent)
+    : QObject(parent), m_config(config), m_ring(config.ringVirtualNodes), m_matchmaker(config.matchmakingRatingBucket)
 {
     connect(&m_server, &QTcpServer::newConnection, this, &Server::onNewConnection);
 
-    const quint16 port = 12345;
-    if (!m_server.listen(QHostAddress::Any, port)) {
-        qFatal("Server listen failed");
+    // Prüft regelmäßig langsame Clients und abgelaufene Platzreservierungen
+    connect(&m_housekeepingTimer, &QTimer::timeout, this, &Server::checkSlowConsumers);
+    connect(&m_housekeepingTimer, &QTimer::timeout, this, &Server::expireReservedSeats);
+    m_housekeepingTimer.start(1000);
+    m_clock.start();
+
+    connect(&m_pingTimer, &QTimer::timeout, this, &Server::sendPings);
+    if (m_config.pingIntervalMs > 0)
+        m_pingTimer.start(m_config.pingIntervalMs);
+
+    m_spectatorTimer.setSingleShot(true);
+    connect(&m_spectatorTimer, &QTimer::timeout, this, &Server::flushSpectators);
+
+    connect(&m_matchmakingTimer, &QTimer::timeout, this, &Server::runMatchmaking);
+    m_matchmakingTimer.start(m_config.matchmakingIntervalMs);
+
+    if (m_config.workerIndex >= 0) {
+        // Worker hinter dem Router: Verbindungen kommen fertig angenommen per Unix-Socket
+        for (int i = 0; i < m_config.workerCount; ++i)
+            m_ring.addNode(i);
+        connect(&m_handoff, &FdHandoffListener::connectionReceived, this, &Server::adoptConnection);
+        const QString path = FdHandoff::socketPath(m_config.workerSocketPrefix, m_config.workerIndex);
+        if (!m_handoff.listen(path)) {
+            qFatal("Handoff socket listen failed");
+        }
+        qInfo() << "[NET] Worker" << m_config.workerIndex << "of" << m_config.workerCount << "listening on" << path;
+        return;
+    }
+
+    const int activatedFd = HotRestart::systemdListenFd();
+    if (!m_config.takeoverFrom.isEmpty()) {
+        takeOver();
+    } else if (activatedFd >= 0) {
+        if (!m_server.setSocketDescriptor(activatedFd)) {
+            qFatal("Socket-activated listener unusable");
+        }
+        qInfo() << "[NET] Server using socket-activated listener on port" << m_server.serverPort();
+    } else {
+        const quint16 port = m_config.port;
+        if (!m_server.listen(QHostAddress::Any, port)) {
+            qFatal("Server listen failed");
+        }
+        qInfo() << "[NET] Server listening on port" << port;
+    }
+
+    if (!m_config.controlSocket.isEmpty()) {
+        connect(&m_hotRestart, &HotRestartListener::takeoverRequested, this, &Server::beginHandOver);
+        if (!m_hotRestart.listen(m_config.controlSocket))
+            qWarning() << "[NET] control socket" << m_config.controlSocket << "unavailable, hot restart disabled";
     }
-    qInfo() << "[NET] Server listening on port" << port;
 }
 
 //Wenn ein Client sich mit dem Server verbindet, wird hier die Clientverbindung angenommen und im Terminal ausgegeben
@@ -58,46 +115,132 @@ void Server::onNewConnection()
         QTcpSocket* sock = m_server.nextPendingConnection();
         qInfo() << "[NET] Client connected from"
                 << sock->peerAddress().toString() << ":" << sock->peerPort();
+        setupConnection(sock);
+    }
+}
+
+//Registriert Signale, Lesepuffer und Rate-Limits einer neuen Verbindung
+void Server::setupConnection(QTcpSocket* sock)
+{
+    connect(sock, &QTcpSocket::readyRead, this, [this, sock]() { onReadyRead(sock); });
+    connect(sock, &QTcpSocket::disconnected, this, [this, sock]() { onDisconnected(sock); });
+    connect(sock, &QTcpSocket::bytesWritten, this, [this, sock]() { onBytesWritten(sock); });
 
-        connect(sock, &QTcpSocket::readyRead, this, [this, sock]() { onReadyRead(sock); });
-        connect(sock, &QTcpSocket::disconnected, this, [this, sock]() { onDisconnected(sock); });
+    // Begrenzter Lesepuffer: wenn wir gedrosselt nicht lesen, staut sich der Rest im Kernel (TCP-Backpressure)
+    sock->setReadBufferSize(m_config.readBufferSize);
+
+    ConnectionState conn;
+    conn.peerIp = sock->peerAddress().toString();
+    conn.rateLimit = TokenBucket(m_config.msgRatePerConnection, m_config.msgBurstPerConnection);
+
+    IpState& ip = m_ipStates[conn.peerIp];
+    if (ip.connections++ == 0)
+        ip.rateLimit = TokenBucket(m_config.msgRatePerIp, m_config.msgBurstPerIp);
+
+    m_connections.insert(sock, conn);
+}
 
-        m_buffers.insert(sock, QByteArray());
+//Übernimmt eine vom Router weitergereichte Verbindung; die schon gelesenen Bytes werden wie frisch empfangen verarbeitet
+void Server::adoptConnection(qintptr fd, const QByteArray& initialBytes)
+{
+    auto* sock = new QTcpSocket(this);
+    if (!sock->setSocketDescriptor(fd)) {
+        qWarning() << "[NET] could not adopt handed-off socket:" << sock->errorString();
+        delete sock;
+        FdHandoff::closeFd(int(fd));
+        return;
     }
+    ++m_metrics.adoptedConnections;
+    qInfo() << "[NET] Client handed over from"
+            << sock->peerAddress().toString() << ":" << sock->peerPort();
+
+    setupConnection(sock);
+    m_connections[sock].inBuffer = initialBytes;
+    onReadyRead(sock);
 }
 
-//Wenn sich ein Nutzer disconnected, wird er hier aus der Empfänger Liste entfernt und falls das Spiel leer ist wird das Spiel geschlossen
+//Wenn sich ein Nutzer disconnected, wird er hier aus der Empfänger Liste entfernt. Im laufenden Spiel bleibt sein Platz für die Frist reserviert
 void Server::onDisconnected(QTcpSocket* sock)
 {
-    m_buffers.remove(sock);
+    const ConnectionState conn = m_connections.take(sock);
+    auto ipIt = m_ipStates.find(conn.peerIp);
+    if (ipIt != m_ipStates.end() && --ipIt->connections <= 0)
+        m_ipStates.erase(ipIt);
+
+    m_matchmaker.remove(sock);
+
+    const QString watched = m_spectatorToGame.take(sock);
+    if (GameState* wg = getGame(watched))
+        wg->spectators.remove(sock);
 
     const QString code = m_socketToGame.take(sock);
-    if (!code.isEmpty() && m_games.contains(code)) {
-        GameState& g = m_games[code];
-        g.players.removeAll(sock);
-        g.hands.remove(sock);
-        if (g.host == sock) g.host = nullptr;
+    if (GameState* g = getGame(code)) {
+        const int seatIndex = indexOfPlayer(g, sock);
+        if (g->host == sock) g->host = nullptr;
+
+        if (seatIndex >= 0 && g->started && !g->finished) {
+            PlayerSeat& seat = g->seats[seatIndex];
+            seat.sock = nullptr;
+            seat.disconnectedAtMs = m_clock.elapsed();
+            broadcast(g, QJsonObject{{"type","player_disconnected"},
+                                     {"playerIndex",seatIndex},
+                                     {"graceMs",m_config.seatGraceMs}});
+            appendLog(g, "disconnect", seatIndex, "reserved");
+        } else if (seatIndex >= 0 && !g->started) {
+            g->seats.removeAt(seatIndex);
+        } else if (seatIndex >= 0) {
+            g->seats[seatIndex].sock = nullptr;
+        }
 
-        if (g.players.isEmpty())
-            m_games.remove(code);
+        bool anyConnected = false;
+        for (const PlayerSeat& seat : g->seats)
+            anyConnected = anyConnected || seat.sock;
+        if (!anyConnected && (!g->started || g->finished))
+            removeGame(code);
     }
 
     qInfo() << "[NET] Client disconnected";
     sock->deleteLater();
 }
 
-//Liest alle gesendeten Daten vom Client, verarbeitet Sie und sendet diese an handleMessage weiter
+//Liest alle gesendeten Daten vom Client, verarbeitet Sie und sendet diese an handleMessage weiter.
+//Neue Bytes werden nur ab scanFrom nach '\n' durchsucht, der Puffer wird einmal pro Aufruf gekürzt.
 void Server::onReadyRead(QTcpSocket* sock)
 {
-    QByteArray& buf = m_buffers[sock];
-    buf += sock->readAll();
+    auto it = m_connections.find(sock);
+    if (it == m_connections.end() || m_handingOver)
+        return;
+
+    // Verbindung wird gerade geschlossen: alles Eingehende wird ungelesen verworfen
+    if (it->closing) {
+        m_metrics.discardedBytes += quint64(qMax<qint64>(0, sock->skip(sock->bytesAvailable())));
+        return;
+    }
+    if (it->throttled)
+        return;
+
+    it->inBuffer += sock->readAll();
 
+    int consumed = 0;
+    bool pausedWithLine = false;
     while (true) {
-        const int nl = buf.indexOf('\n');
+        QByteArray& buf = it->inBuffer;
+        const int nl = buf.indexOf('\n', qMax(consumed, it->scanFrom));
         if (nl < 0) break;
 
-        const QByteArray line = buf.left(nl).trimmed();
-        buf.remove(0, nl + 1);
+        if (nl - consumed > (it->admin ? m_config.maxAdminFrameSize : m_config.maxFrameSize)) {
+            rejectOversizedFrame(sock, *it);
+            return;
+        }
+
+        // Rate-Limit vor dem Parsen: ohne Token wird das Lesen pausiert
+        if (!takeMessageToken(sock, *it)) {
+            pausedWithLine = true;
+            break;
+        }
+
+        const QByteArray line = buf.mid(consumed, nl - consumed).trimmed();
+        consumed = nl + 1;
 
         if (line.isEmpty()) continue;
 
@@ -108,15 +251,102 @@ void Server::onReadyRead(QTcpSocket* sock)
             continue;
         }
 
+        QElapsedTimer processing;
+        processing.start();
         handleMessage(sock, doc.object());
+        m_metrics.processing.add(processing.nsecsElapsed() / 1000);
+
+        // handleMessage kann Verbindungen anlegen oder schließen, daher neu nachschlagen
+        it = m_connections.find(sock);
+        if (it == m_connections.end() || it->closing)
+            return;
+    }
+
+    QByteArray& buf = it->inBuffer;
+    buf.remove(0, consumed);
+    it->scanFrom = pausedWithLine ? 0 : buf.size();
+
+    // Angefangene Zeile ohne '\n' ist schon größer als erlaubt
+    if (buf.size() > (it->admin ? m_config.maxAdminFrameSize : m_config.maxFrameSize))
+        rejectOversizedFrame(sock, *it);
+}
+
+//Frame über dem Limit: Puffer verwerfen, Fehler senden und die Verbindung schließen
+void Server::rejectOversizedFrame(QTcpSocket* sock, ConnectionState& conn)
+{
+    ++m_metrics.oversizedFrames;
+    m_metrics.discardedBytes += quint64(conn.inBuffer.size());
+    qInfo() << "[NET] frame too large from" << conn.peerIp << "buffered=" << conn.inBuffer.size();
+
+    conn.inBuffer.clear();
+    conn.inBuffer.squeeze();
+    conn.scanFrom = 0;
+
+    sendJson(sock, QJsonObject{{"type","error"},{"message","Frame too large"}});
+    conn.closing = true;
+    conn.pendingStateUpdate.clear();
+
+    QMetaObject::invokeMethod(sock, [sock]() { sock->disconnectFromHost(); }, Qt::QueuedConnection);
+    // Falls der Client den Fehler nie abholt, wird hart getrennt
+    QTimer::singleShot(5000, sock, [sock]() { sock->abort(); });
+}
+
+//Holt ein Token aus dem Bucket der Verbindung und der IP. Ist keins da, wird das Lesen bis zum nächsten Token pausiert
+bool Server::takeMessageToken(QTcpSocket* sock, ConnectionState& conn)
+{
+    const qint64 now = m_clock.elapsed();
+    IpState& ip = m_ipStates[conn.peerIp];
+
+    if (conn.rateLimit.available(now) && ip.rateLimit.available(now)) {
+        conn.rateLimit.consume();
+        ip.rateLimit.consume();
+        return true;
     }
+
+    const qint64 waitMs = qMax(conn.rateLimit.msUntilAvailable(now), ip.rateLimit.msUntilAvailable(now));
+    conn.throttled = true;
+    ++m_metrics.throttledReads;
+    QTimer::singleShot(qMax<qint64>(1, waitMs), sock, [this, sock]() { resumeReading(sock); });
+    return false;
+}
+
+//Hebt die Drosselung auf und verarbeitet, was inzwischen im Puffer liegt
+void Server::resumeReading(QTcpSocket* sock)
+{
+    auto it = m_connections.find(sock);
+    if (it == m_connections.end())
+        return;
+    it->throttled = false;
+    onReadyRead(sock);
 }
 
 //Handled die Messages, differenziert die fälle "Create, Join, Start, Karte ziehen, Karte legen, Uno deklarieren" und ruft die nötigen Methoden zur Weiterverarbeitung auf
 void Server::handleMessage(QTcpSocket* sock, const QJsonObject& msg)
 {
     const QString type = msg.value("type").toString();
-    qInfo() << "[RX]" << msg;
+
+    // Antwort auf unseren ping: kommt alle paar Sekunden, daher ohne [RX]-Log
+    if (type == "pong") {
+        handlePong(sock, msg);
+        return;
+    }
+
+    qInfo() << "[RX]" << (type == "import_game" ? QJsonObject{{"type",type}} : msg);
+
+    // Während einer Migration ist das Spiel eingefroren, die Clients werden gleich umgeleitet
+    if (type == "draw_cards" || type == "play_card" || type == "declare_uno"
+        || type == "start_game" || type == "join_game" || type == "add_bot") {
+        const QString code = msg.contains("code") ? msg.value("code").toString().trimmed().toUpper()
+                                                  : m_socketToGame.value(sock);
+        const GameState* g = getGame(code);
+        if (g && g->migrating) {
+            QJsonObject err{{"type","error"},{"message","Game is migrating"}};
+            if (msg.contains("clientSeq"))
+                err.insert("clientSeq", msg.value("clientSeq"));
+            sendJson(sock, err);
+            return;
+        }
+    }
 
     if (type == "create_game") {
         createGame(sock);
@@ -129,6 +359,8 @@ void Server::handleMessage(QTcpSocket* sock, const QJsonObject& msg)
             sendJson(sock, QJsonObject{{"type","error"},{"message","Missing code"}});
             return;
         }
+        if (redirectIfForeign(sock, code, msg))
+            return;
         joinGame(sock, code);
         return;
     }
@@ -150,13 +382,18 @@ void Server::handleMessage(QTcpSocket* sock, const QJsonObject& msg)
     }
 
     if (type == "play_card") {
+        // clientSeq: Nummer des vorhergesagten Zugs im Client, kommt in einem error zurück
+        const qint64 clientSeq = msg.contains("clientSeq") ? qint64(msg.value("clientSeq").toDouble()) : -1;
         const QString card = msg.value("card").toString();
         if (card.isEmpty()) {
-            sendJson(sock, QJsonObject{{"type","error"},{"message","Missing card"}});
+            QJsonObject err{{"type","error"},{"message","Missing card"}};
+            if (clientSeq >= 0)
+                err.insert("clientSeq", double(clientSeq));
+            sendJson(sock, err);
             return;
         }
         const QString chosenColor = msg.value("chosenColor").toString();
-        playCard(sock, card, chosenColor);
+        playCard(sock, card, chosenColor, clientSeq);
         return;
     }
 
@@ -165,6 +402,96 @@ void Server::handleMessage(QTcpSocket* sock, const QJsonObject& msg)
         return;
     }
 
+    if (type == "spectate_game") {
+        const QString code = msg.value("code").toString().trimmed().toUpper();
+        if (code.isEmpty()) {
+            sendJson(sock, QJsonObject{{"type","error"},{"message","Missing code"}});
+            return;
+        }
+        if (redirectIfForeign(sock, code, msg))
+            return;
+        spectateGame(sock, code);
+        return;
+    }
+
+    if (type == "queue_join") {
+        const int tableSize = msg.value("size").toInt(2);
+        const int rating = msg.value("rating").toInt(Matchmaker::NoRating);
+        queueJoin(sock, tableSize, rating);
+        return;
+    }
+
+    if (type == "queue_leave") {
+        if (!m_matchmaker.remove(sock)) {
+            sendJson(sock, QJsonObject{{"type","error"},{"message","Not queued"}});
+            return;
+        }
+        sendJson(sock, QJsonObject{{"type","queue_left"}});
+        return;
+    }
+
+    if (type == "add_bot") {
+        const QString code = msg.value("code").toString().trimmed().toUpper();
+        if (code.isEmpty()) {
+            sendJson(sock, QJsonObject{{"type","error"},{"message","Missing code"}});
+            return;
+        }
+        addBot(sock, code, msg.value("level").toString() == "strong");
+        return;
+    }
+
+    if (type == "resume") {
+        const QString token = msg.value("token").toString();
+        if (token.isEmpty()) {
+            sendJson(sock, QJsonObject{{"type","error"},{"message","Missing token"}});
+            return;
+        }
+        // Token-Präfix ist der Spielcode, genau wie der Router ihn auswertet
+        if (redirectIfForeign(sock, token.section('.', 0, 0), msg))
+            return;
+        resumeSession(sock, token, quint64(msg.value("lastSeq").toDouble(0)));
+        return;
+    }
+
+    if (type == "get_metrics") {
+        sendJson(sock, metricsJson());
+        return;
+    }
+
+    if (type == "admin_hello") {
+        if (checkAdmin(sock, msg))
+            sendJson(sock, QJsonObject{{"type","admin_ok"}});
+        return;
+    }
+
+    if (type == "migrate_game") {
+        if (!checkAdmin(sock, msg))
+            return;
+        const QString code = msg.value("code").toString().trimmed().toUpper();
+        const QString host = msg.value("host").toString();
+        const int port = msg.value("port").toInt();
+        if (code.isEmpty() || host.isEmpty() || port <= 0 || port > 65535) {
+            sendJson(sock, QJsonObject{{"type","error"},{"message","Missing code or target"}});
+            return;
+        }
+        migrateGame(sock, code, host, quint16(port));
+        return;
+    }
+
+    if (type == "set_workers") {
+        if (!checkAdmin(sock, msg))
+            return;
+        setWorkerCount(sock, msg.value("count").toInt());
+        return;
+    }
+
+    if (type == "import_game") {
+        if (!checkAdmin(sock, msg))
+            return;
+        importGame(sock, QByteArray::fromBase64(msg.value("snapshot").toString().toLatin1()));
+        return;
+    }
+
     sendJson(sock, QJsonObject{{"type","error"},{"message","Unknown message type"}});
 }
 
@@ -188,15 +515,27 @@ void Server::drawCards(QTcpSocket* sock, int count)
         sendJson(sock, QJsonObject{{"type","error"},{"message","Game finished"}});
         return;
     }
-    if (!g->players.contains(sock)) {
+    const int seatIndex = indexOfPlayer(g, sock);
+    if (seatIndex < 0) {
         sendJson(sock, QJsonObject{{"type","error"},{"message","Not a player"}});
         return;
     }
-    if (g->currentPlayerIndex != g->players.indexOf(sock)) {
+    if (g->currentPlayerIndex != seatIndex) {
         sendJson(sock, QJsonObject{{"type","error"},{"message","Not your turn"}});
         return;
     }
 
+    QString error;
+    if (!drawCardsForSeat(g, seatIndex, count, &error)) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message",error}});
+        return;
+    }
+    scheduleBotTurn(g);
+}
+
+//Zieht Karten für den Platz, der am Zug ist (gemeinsam für Spieler und Bots)
+bool Server::drawCardsForSeat(GameState* g, int seatIndex, int count, QString* error)
+{
     applyUnoPenaltyIfNeeded(g, g->currentPlayerIndex);
 
     if (g->pendingUnoPlayerIndex == g->currentPlayerIndex) {
@@ -204,26 +543,20 @@ void Server::drawCards(QTcpSocket* sock, int count)
         g->pendingUnoDeclared = false;
     }
 
-    QStringList& hand = g->hands[sock];
     QJsonArray cardsArr;
-
-    for (int i = 0; i < count; ++i) {
-        refillDeck(g);
-        if (g->deck.isEmpty()) break;
-        const QString card = g->deck.takeLast();
-        hand.append(card);
+    for (const QString& card : drawCardsToPlayer(g, seatIndex, count))
         cardsArr.append(card);
-    }
 
     if (cardsArr.isEmpty()) {
-        sendJson(sock, QJsonObject{{"type","error"},{"message","Deck is empty"}});
-        return;
+        if (error) *error = "Deck is empty";
+        return false;
     }
 
     const int drawingPlayerIndex = g->currentPlayerIndex;
-    g->currentPlayerIndex = advanceIndex(g->currentPlayerIndex, 1, g->direction, g->players.size());
+    g->currentPlayerIndex = UnoRules::advanceIndex(g->currentPlayerIndex, 1, g->direction, g->seats.size());
+    skipAbandonedSeats(g);
 
-    sendJson(sock, QJsonObject{
+    sendJson(g->seats[seatIndex].sock, QJsonObject{
                        {"type","cards_drawn"},
                        {"cards",cardsArr},
                        {"drawCount",g->deck.size()},
@@ -233,62 +566,299 @@ void Server::drawCards(QTcpSocket* sock, int count)
     sendStateUpdate(g);
     appendLog(g, "draw", drawingPlayerIndex, QString::number(cardsArr.size()));
 
-    qInfo() << "[GAME]" << code << "draw_cards count=" << cardsArr.size()
+    qInfo() << "[GAME]" << g->code << "draw_cards count=" << cardsArr.size()
             << "remaining=" << g->deck.size();
+    return true;
 }
 
 //Sendet die Nachricht an den Client
 void Server::sendJson(QTcpSocket* sock, const QJsonObject& obj)
 {
-    const QByteArray payload = QJsonDocument(obj).toJson(QJsonDocument::Compact) + "\n";
+    writePayload(sock, encodeJson(obj), obj.value("type").toString() == "state_update");
+}
+
+//Sendet ein Event an alle Spieler und Zuschauer eines Spiels. Serialisiert wird nur einmal
+void Server::broadcast(GameState* g, const QJsonObject& obj)
+{
+    if (!g) return;
+
+    // Jede öffentliche Nachricht bekommt eine Sequenznummer, damit ein Client nach dem Reconnect
+    // nur die verpassten Events nachgeliefert bekommt
+    QJsonObject event = obj;
+    event.insert("seq", double(++g->eventSeq));
+    const QByteArray payload = encodeJson(event);
+    const bool supersedable = obj.value("type").toString() == "state_update";
+
+    g->recentEvents.append(qMakePair(g->eventSeq, payload));
+    while (g->recentEvents.size() > m_config.resumeEventBacklog)
+        g->recentEvents.removeFirst();
+
+    for (const PlayerSeat& seat : g->seats)
+        writePayload(seat.sock, payload, supersedable);
+    publishToSpectators(g, payload, supersedable);
+}
+
+//Reiht ein öffentliches Event für die Zuschauer (oder nur für target) ein. Zugestellt wird erst nach den Spielern (bzw. nach der Verzögerung)
+void Server::publishToSpectators(GameState* g, const QByteArray& payload, bool supersedable, QTcpSocket* target)
+{
+    if (!g || g->spectators.isEmpty())
+        return;
+
+    const qint64 delay = qMax(0, m_config.spectatorDelayMs);
+    if (!g->spectators.enqueue(payload, supersedable, m_clock.elapsed() + delay, target))
+        ++m_metrics.spectatorEventsDropped;
+    m_gamesWithSpectatorEvents.insert(g->code);
+    scheduleSpectatorFlush(delay);
+}
+
+//Stellt sicher, dass flushSpectators spätestens nach delayMs läuft
+void Server::scheduleSpectatorFlush(qint64 delayMs)
+{
+    delayMs = qMax<qint64>(0, delayMs);
+    if (m_spectatorTimer.isActive() && m_spectatorTimer.remainingTime() <= delayMs)
+        return;
+    m_spectatorTimer.start(int(delayMs));
+}
+
+//Verteilt alle fälligen Zuschauer-Events der Spiele, in denen etwas offen ist
+void Server::flushSpectators()
+{
+    const qint64 now = m_clock.elapsed();
+    qint64 nextDue = -1;
+
+    for (auto it = m_gamesWithSpectatorEvents.begin(); it != m_gamesWithSpectatorEvents.end();) {
+        GameState* g = getGame(*it);
+        if (!g) {
+            it = m_gamesWithSpectatorEvents.erase(it);
+            continue;
+        }
+
+        g->spectators.deliverDue(now, [this](QTcpSocket* s, const QByteArray& payload, bool supersedable) {
+            writePayload(s, payload, supersedable);
+        });
+
+        const qint64 due = g->spectators.nextDueMs();
+        if (due < 0) {
+            it = m_gamesWithSpectatorEvents.erase(it);
+            continue;
+        }
+        if (nextDue < 0 || due < nextDue)
+            nextDue = due;
+        ++it;
+    }
+
+    if (nextDue >= 0)
+        scheduleSpectatorFlush(nextDue - now);
+}
+
+//Schreibt in den Socket und beachtet dabei High/Low-Watermark. Bei langsamen Clients wird nur das neueste state_update behalten
+void Server::writePayload(QTcpSocket* sock, const QByteArray& payload, bool supersedable)
+{
+    auto it = m_connections.find(sock);
+    if (it == m_connections.end() || it->closing)
+        return;
+    ConnectionState& conn = *it;
+
+    if (conn.slow && supersedable) {
+        if (!conn.pendingStateUpdate.isEmpty())
+            ++m_metrics.droppedStateUpdates;
+        conn.pendingStateUpdate = payload;
+        return;
+    }
+
+    if (sock->bytesToWrite() + payload.size() > m_config.outHardLimit) {
+        dropConnection(sock, conn, "write buffer over hard limit");
+        return;
+    }
+
     sock->write(payload);
     sock->flush();
+
+    if (!conn.slow && sock->bytesToWrite() > m_config.outHighWatermark) {
+        conn.slow = true;
+        conn.slowSince.start();
+        qInfo() << "[NET] slow consumer" << sock->peerAddress().toString()
+                << "queued=" << sock->bytesToWrite();
+    }
 }
 
-//Indexiert jeden Spieler
-int Server::indexOfPlayer(GameState* g, QTcpSocket* sock) const
+//Sobald der Schreibpuffer unter die Low-Watermark fällt, wird das zurückgehaltene state_update nachgeschickt
+void Server::onBytesWritten(QTcpSocket* sock)
 {
-    return g ? g->players.indexOf(sock) : -1;
+    auto it = m_connections.find(sock);
+    if (it == m_connections.end() || !it->slow || it->closing)
+        return;
+    if (sock->bytesToWrite() > m_config.outLowWatermark)
+        return;
+
+    it->slow = false;
+    const QByteArray pending = std::exchange(it->pendingStateUpdate, QByteArray());
+    if (!pending.isEmpty())
+        writePayload(sock, pending, true);
 }
 
-//Prüft ob eine Karte gelegt werden darf, bevor der Spieler sie legt
-bool Server::isCardLegal(const QString& card, const QString& topDiscard, const QString& currentColor) const
+//Trennt Clients, die länger als erlaubt über der High-Watermark bleiben
+void Server::checkSlowConsumers()
 {
-    if (topDiscard.isEmpty())
-        return true;
+    for (auto it = m_connections.begin(); it != m_connections.end(); ++it) {
+        if (it->slow && !it->closing && it->slowSince.elapsed() > m_config.slowConsumerTimeoutMs)
+            dropConnection(it.key(), it.value(), "slow consumer timeout");
+    }
+}
 
-    const CardInfo playInfo = parseCardInfo(card);
-    if (playInfo.isWild)
-        return true;
+//Bricht die Verbindung ab. Das eigentliche abort() läuft verzögert, damit laufende Schleifen über g->seats gültig bleiben
+void Server::dropConnection(QTcpSocket* sock, ConnectionState& conn, const char* reason)
+{
+    conn.closing = true;
+    conn.pendingStateUpdate.clear();
+    ++m_metrics.slowConsumerDisconnects;
+    qInfo() << "[NET] dropping client" << sock->peerAddress().toString() << "reason:" << reason
+            << "queued=" << sock->bytesToWrite();
+    QMetaObject::invokeMethod(sock, [sock]() { sock->abort(); }, Qt::QueuedConnection);
+}
+
+//Zähler für Monitoring (Antwort auf "get_metrics")
+QJsonObject Server::metricsJson() const
+{
+    return QJsonObject{
+        {"type","metrics"},
+        {"connections", m_connections.size()},
+        {"games", m_games.size()},
+        {"droppedStateUpdates", double(m_metrics.droppedStateUpdates)},
+        {"slowConsumerDisconnects", double(m_metrics.slowConsumerDisconnects)},
+        {"throttledReads", double(m_metrics.throttledReads)},
+        {"spectators", m_spectatorToGame.size()},
+        {"queued", m_matchmaker.queuedCount()},
+        {"spectatorEventsDropped", double(m_metrics.spectatorEventsDropped)},
+        {"adoptedConnections", double(m_metrics.adoptedConnections)},
+        {"gamesMigratedOut", double(m_metrics.gamesMigratedOut)},
+        {"gamesMigratedIn", double(m_metrics.gamesMigratedIn)},
+        {"oversizedFrames", double(m_metrics.oversizedFrames)},
+        {"discardedBytes", double(m_metrics.discardedBytes)},
+        {"maxFrameSize", m_config.maxFrameSize},
+        {"rtt", m_metrics.rtt.toJson()},
+        {"processing", m_metrics.processing.toJson()},
+        {"foreignGames", foreignGames()}
+    };
+}
+
+//Schickt jeder Verbindung einen ping; ein unbeantworteter wird durch den neuen ersetzt
+void Server::sendPings()
+{
+    if (m_handingOver)
+        return;
+    const qint64 wallMs = QDateTime::currentMSecsSinceEpoch();
+    for (auto it = m_connections.begin(); it != m_connections.end(); ++it) {
+        ConnectionState& conn = it.value();
+        if (conn.closing || conn.admin)
+            continue;
+        ++conn.pingId;
+        conn.pingSentNs = m_clock.nsecsElapsed();
+        conn.pingSentWallMs = wallMs;
+        sendJson(it.key(), QJsonObject{{"type","ping"},{"id",double(conn.pingId)},{"serverTime",double(wallMs)}});
+    }
+}
 
-    const CardInfo topInfo = parseCardInfo(topDiscard);
-    if (topInfo.isWild)
-        return !currentColor.isEmpty() && playInfo.color == currentColor;
+//Wertet ein pong aus (NTP-artig: t1 ping gesendet, t2/t3 Client empfangen/gesendet, t4 jetzt).
+//Die Haltezeit im Client (t3 - t2) zählt nicht zur RTT, so bleibt nur das Netzwerk übrig.
+void Server::handlePong(QTcpSocket* sock, const QJsonObject& msg)
+{
+    auto it = m_connections.find(sock);
+    if (it == m_connections.end())
+        return;
+    ConnectionState& conn = it.value();
+    if (conn.pingSentNs < 0 || quint32(msg.value("id").toDouble()) != conn.pingId)
+        return;
+
+    const qint64 t1 = conn.pingSentWallMs;
+    const qint64 t2 = qint64(msg.value("clientRecv").toDouble());
+    const qint64 t3 = qint64(msg.value("clientSend").toDouble());
+    const qint64 t4 = QDateTime::currentMSecsSinceEpoch();
+    const qint64 holdUs = qMax<qint64>(0, t3 - t2) * 1000;
+    const qint64 rttUs = qMax<qint64>(0, (m_clock.nsecsElapsed() - conn.pingSentNs) / 1000 - holdUs);
+    conn.pingSentNs = -1;
+
+    conn.clockOffsetMs = ((t2 - t1) + (t3 - t4)) / 2;
+    const double rttMs = rttUs / 1000.0;
+    conn.smoothedRttMs = conn.smoothedRttMs < 0 ? rttMs : conn.smoothedRttMs + (rttMs - conn.smoothedRttMs) / 8.0;
+    conn.rtt.add(rttUs);
+    m_metrics.rtt.add(rttUs);
+
+    // Messwerte zurück an den Client (Debug-Anzeige); processing ist serverweit
+    const QJsonObject rtt = conn.rtt.toJson();
+    const QJsonObject processing = m_metrics.processing.toJson();
+    sendJson(sock, QJsonObject{
+        {"type","latency"},
+        {"rttMs", rttMs},
+        {"smoothedRttMs", conn.smoothedRttMs},
+        {"clockOffsetMs", double(conn.clockOffsetMs)},
+        {"samples", rtt.value("count")},
+        {"rttP50Ms", rtt.value("p50Ms")},
+        {"rttP95Ms", rtt.value("p95Ms")},
+        {"rttP99Ms", rtt.value("p99Ms")},
+        {"processingP50Ms", processing.value("p50Ms")},
+        {"processingP95Ms", processing.value("p95Ms")}
+    });
+}
+
+//Indexiert jeden Spieler
+int Server::indexOfPlayer(GameState* g, QTcpSocket* sock) const
+{
+    if (!g || !sock) return -1;
+    for (int i = 0; i < g->seats.size(); ++i) {
+        if (g->seats[i].sock == sock)
+            return i;
+    }
+    return -1;
+}
 
-    return playInfo.color == topInfo.color || playInfo.value == topInfo.value;
+//Überspringt Plätze, deren Reservierung abgelaufen ist
+void Server::skipAbandonedSeats(GameState* g)
+{
+    if (!g || activeSeatCount(g) == 0)
+        return;
+    while (g->seats.value(g->currentPlayerIndex).abandoned)
+        g->currentPlayerIndex = UnoRules::advanceIndex(g->currentPlayerIndex, 1, g->direction, g->seats.size());
 }
 
-//Erhöht den Index bei mehreren Personen
-int Server::advanceIndex(int startIndex, int steps, int direction, int playerCount) const
+//Nächster Platz in Spielrichtung, der noch im Spiel ist (fromIndex selbst, wenn sonst keiner mehr)
+int Server::nextActiveSeat(const GameState* g, int fromIndex) const
 {
-    if (playerCount <= 0)
-        return 0;
-    int idx = startIndex;
-    for (int i = 0; i < steps; ++i) {
-        idx = (idx + direction) % playerCount;
-        if (idx < 0) idx += playerCount;
+    const int playerCount = g->seats.size();
+    int index = fromIndex;
+    for (int i = 0; i < playerCount; ++i) {
+        index = UnoRules::advanceIndex(index, 1, g->direction, playerCount);
+        if (!g->seats[index].abandoned)
+            return index;
     }
-    return idx;
+    return fromIndex;
+}
+
+//Anzahl der Plätze, die noch im Spiel sind (verbunden oder innerhalb der Frist)
+int Server::activeSeatCount(const GameState* g) const
+{
+    int active = 0;
+    for (const PlayerSeat& seat : g->seats)
+        active += seat.abandoned ? 0 : 1;
+    return active;
+}
+
+//Prüft ob eine Karte gelegt werden darf, bevor der Spieler sie legt
+bool Server::isCardLegal(const QString& card, const QString& topDiscard, const QString& currentColor) const
+{
+    // Gleiche Regel wie für die Bots, siehe CardCatalog::isLegal
+    const int topIndex = topDiscard.isEmpty() ? -1 : CardCatalog::indexOf(topDiscard);
+    return CardCatalog::isLegal(CardCatalog::indexOf(card), topIndex, CardCatalog::colorFromName(currentColor));
 }
 
 //Übernimmt die Funktion, die gezogene Karte in das Deck des Spielers zu legen
-QStringList Server::drawCardsToPlayer(GameState* g, QTcpSocket* sock, int count)
+QStringList Server::drawCardsToPlayer(GameState* g, int seatIndex, int count)
 {
     QStringList drawn;
-    if (!g || !sock || count <= 0)
+    if (!g || seatIndex < 0 || seatIndex >= g->seats.size() || count <= 0)
         return drawn;
 
-    QStringList& hand = g->hands[sock];
+    QStringList& hand = g->seats[seatIndex].hand;
     for (int i = 0; i < count; ++i) {
         refillDeck(g);
         if (g->deck.isEmpty())
@@ -341,11 +911,11 @@ void Server::applyUnoPenaltyIfNeeded(GameState* g, int currentPlayerIndex)
         return;
 
     const int penalizedIndex = g->pendingUnoPlayerIndex;
-    QTcpSocket* penalizedSock = g->players.value(penalizedIndex, nullptr);
-    if (!penalizedSock)
+    if (penalizedIndex >= g->seats.size())
         return;
+    QTcpSocket* penalizedSock = g->seats[penalizedIndex].sock;
 
-    QStringList drawn = drawCardsToPlayer(g, penalizedSock, 2);
+    QStringList drawn = drawCardsToPlayer(g, penalizedIndex, 2);
     if (!drawn.isEmpty()) {
         QJsonArray cardsArr;
         for (const QString& c : drawn)
@@ -368,27 +938,33 @@ void Server::sendStateUpdate(GameState* g, const QString& lastPlayedCard, int pl
 {
     if (!g) return;
 
+    QJsonObject state = publicState(g);
+    state.insert("type", "state_update");
+
+    if (!lastPlayedCard.isEmpty())
+        state.insert("lastPlayedCard", lastPlayedCard);
+    if (playedBy >= 0)
+        state.insert("playedBy", playedBy);
+
+    broadcast(g, state);
+}
+
+//Öffentlicher Spielstand ohne Handkarten (für state_update und Zuschauer)
+QJsonObject Server::publicState(GameState* g) const
+{
     QJsonArray counts;
-    for (QTcpSocket* p : g->players)
-        counts.append(g->hands.value(p).size());
+    for (const PlayerSeat& seat : g->seats)
+        counts.append(seat.hand.size());
 
-    QJsonObject state{
-        {"type","state_update"},
+    return QJsonObject{
         {"discardTop", g->discard.isEmpty() ? QString() : g->discard.last()},
         {"drawCount", g->deck.size()},
         {"currentPlayerIndex", g->currentPlayerIndex},
         {"handCounts", counts},
         {"currentColor", g->currentColor},
+        {"direction", g->direction},
         {"finished", g->finished}
     };
-
-    if (!lastPlayedCard.isEmpty())
-        state.insert("lastPlayedCard", lastPlayedCard);
-    if (playedBy >= 0)
-        state.insert("playedBy", playedBy);
-
-    for (QTcpSocket* p : g->players)
-        sendJson(p, state);
 }
 
 //Erstellt einen 4 Stelligen Spielcode
@@ -411,30 +987,105 @@ GameState* Server::getGame(const QString& code)
     return &m_games[code];
 }
 
-//erstellt ein neues Spiel
-void Server::createGame(QTcpSocket* hostSock)
+//Sucht einen noch freien Spielcode, leer wenn keiner gefunden wurde
+QString Server::allocateCode() const
 {
-    if (m_socketToGame.contains(hostSock)) {
-        sendJson(hostSock, QJsonObject{{"type","error"},{"message","Already in a game"}});
-        return;
+    // Im Worker-Modus gehört nur etwa jeder n-te Code diesem Prozess
+    const int maxTries = 20 * qMax(1, m_config.workerCount);
+    for (int tries = 0; tries < maxTries; ++tries) {
+        const QString code = createCode();
+        if (!m_games.contains(code) && ownsCode(code))
+            return code;
     }
+    return QString();
+}
 
-    QString code;
-    for (int tries = 0; tries < 20; ++tries) {
-        code = createCode();
-        if (!m_games.contains(code)) break;
+//Im Worker-Modus darf nur ein Code vergeben werden, den der Router auch hierher schickt.
+//Spiele, die schon hier laufen, bleiben hier, auch wenn der Ring inzwischen woanders hinzeigt
+bool Server::ownsCode(const QString& code) const
+{
+    return m_config.workerIndex < 0 || m_games.contains(code) || m_ring.nodeFor(code) == m_config.workerIndex;
+}
+
+//Laufende Spiele, deren Code laut Ring einem anderen Worker gehört: Kandidaten für migrate_game.
+//Neue Verbindungen (resume, join) schickt der Router für diese Codes schon zum anderen Worker
+QJsonArray Server::foreignGames() const
+{
+    QJsonArray out;
+    if (m_config.workerIndex < 0)
+        return out;
+    for (auto it = m_games.cbegin(); it != m_games.cend(); ++it) {
+        const int worker = m_ring.nodeFor(it.key());
+        if (worker != m_config.workerIndex)
+            out.append(QJsonObject{{"code",it.key()},{"worker",worker}});
     }
-    if (m_games.contains(code)) {
-        sendJson(hostSock, QJsonObject{{"type","error"},{"message","Could not create code"}});
+    return out;
+}
+
+//Admin: Router läuft jetzt mit count Workern. Ring neu aufbauen und melden, welche Spiele umziehen sollten
+void Server::setWorkerCount(QTcpSocket* sock, int count)
+{
+    if (m_config.workerIndex < 0) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Not a worker"}});
+        return;
+    }
+    if (count <= m_config.workerIndex) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Invalid worker count"}});
         return;
     }
 
-    qInfo() << "[GAME] created code" << code << "host=" << hostSock;
+    m_config.workerCount = count;
+    m_ring = ConsistentHashRing(m_config.ringVirtualNodes);
+    for (int i = 0; i < count; ++i)
+        m_ring.addNode(i);
 
-    GameState g;
-    g.code = code;
+    const QJsonArray foreign = foreignGames();
+    for (const QJsonValue& v : foreign) {
+        const QJsonObject o = v.toObject();
+        qInfo() << "[GAME]" << o.value("code").toString() << "now belongs to worker" << o.value("worker").toInt()
+                << ", migrate_game it there";
+    }
+    sendJson(sock, QJsonObject{{"type","workers_ok"},{"workers",count},{"foreign",foreign}});
+}
+
+//Code gehört einem anderen Worker (Verbindung wurde für ein früheres Spiel hierher geroutet):
+//Client zurück zum Router schicken, der ihn mit derselben Anfrage neu zuordnet
+bool Server::redirectIfForeign(QTcpSocket* sock, const QString& code, const QJsonObject& msg)
+{
+    if (code.isEmpty() || ownsCode(code))
+        return false;
+    // Wer hier noch an einem Spiel hängt, bekommt wie bisher "Already in a game"
+    if (m_socketToGame.contains(sock) || m_spectatorToGame.contains(sock) || m_matchmaker.contains(sock))
+        return false;
+
+    // Leerer Host und Port 0 = gleiche Adresse wie bisher, also der Router. retry schickt der Client nach dem Verbinden.
+    sendJson(sock, QJsonObject{{"type","redirect"},{"host",""},{"port",0},{"code",code},{"retry",msg}});
+    qInfo() << "[NET]" << code << "belongs to worker" << m_ring.nodeFor(code) << ", redirecting" << sock;
+    sock->disconnectFromHost();
+    return true;
+}
+
+//erstellt ein neues Spiel
+void Server::createGame(QTcpSocket* hostSock)
+{
+    if (m_socketToGame.contains(hostSock) || m_matchmaker.contains(hostSock)) {
+        sendJson(hostSock, QJsonObject{{"type","error"},{"message","Already in a game"}});
+        return;
+    }
+
+    const QString code = allocateCode();
+    if (code.isEmpty()) {
+        sendJson(hostSock, QJsonObject{{"type","error"},{"message","Could not create code"}});
+        return;
+    }
+
+    qInfo() << "[GAME] created code" << code << "host=" << hostSock;
+
+    GameState g;
+    g.code = code;
     g.host = hostSock;
-    g.players = { hostSock };
+    g.seats.append(PlayerSeat());
+    g.seats.last().sock = hostSock;
 
     m_games.insert(code, g);
     m_socketToGame.insert(hostSock, code);
@@ -445,7 +1096,7 @@ void Server::createGame(QTcpSocket* hostSock)
 //Tritt einem Spiel bei anhand des Codes
 void Server::joinGame(QTcpSocket* sock, const QString& code)
 {
-    if (m_socketToGame.contains(sock)) {
+    if (m_socketToGame.contains(sock) || m_matchmaker.contains(sock)) {
         sendJson(sock, QJsonObject{{"type","error"},{"message","Already in a game"}});
         return;
     }
@@ -460,55 +1111,708 @@ void Server::joinGame(QTcpSocket* sock, const QString& code)
         return;
     }
 
-    if (!g->players.contains(sock))
-        g->players.append(sock);
+    if (indexOfPlayer(g, sock) < 0) {
+        PlayerSeat seat;
+        seat.sock = sock;
+        g->seats.append(seat);
+    }
 
     m_socketToGame.insert(sock, code);
 
     sendJson(sock, QJsonObject{{"type","join_ok"},{"code",code}});
-    qInfo() << "[GAME]" << code << "player joined, total=" << g->players.size();
+    qInfo() << "[GAME]" << code << "player joined, total=" << g->seats.size();
 }
 
-//Misch das Kartendeck durch
-void Server::shuffle(QStringList& list) const
+//Host fügt vor dem Start einen Bot-Platz hinzu, optional einen starken (ISMCTS) Bot
+void Server::addBot(QTcpSocket* sock, const QString& code, bool strong)
 {
-    for (int i = list.size() - 1; i > 0; --i) {
-        const int j = QRandomGenerator::global()->bounded(i + 1);
-        list.swapItemsAt(i, j);
+    GameState* g = getGame(code);
+    if (!g) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Game not found"}});
+        return;
+    }
+    if (g->host != sock) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Only host can add bots"}});
+        return;
+    }
+    if (g->started) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Game already started"}});
+        return;
     }
+    if ((g->seats.size() + 1) * 6 + 1 > CardCatalog::CardCount) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Table is full"}});
+        return;
+    }
+
+    PlayerSeat seat;
+    seat.bot = true;
+    seat.strongBot = strong;
+    g->seats.append(seat);
+
+    broadcast(g, QJsonObject{{"type","bot_added"},{"playerIndex",g->seats.size() - 1},{"players",g->seats.size()},
+                             {"level", strong ? "strong" : "basic"}});
+    qInfo() << "[GAME]" << code << "bot added, strong=" << strong << "total=" << g->seats.size();
 }
 
-//Liste, welche Karten es alle gibt.
-QStringList Server::buildDeckFromStaticList() const
+//Plant einen Bot-Zug, wenn gerade ein Bot dran ist. Läuft über die Event-Loop, nie direkt im Lesepfad eines Sockets
+void Server::scheduleBotTurn(GameState* g)
 {
-    // Einheitliches Naming:
-    // - Unterstriche statt Leerzeichen
-    // - Dateiendungen exakt wie im assets/images/cards Ordner
+    if (!g || !g->started || g->finished || g->botTurnScheduled || g->migrating || m_handingOver)
+        return;
+    if (!g->seats.value(g->currentPlayerIndex).bot)
+        return;
+
+    g->botTurnScheduled = true;
+    const QString code = g->code;
+    QTimer::singleShot(m_config.botMoveDelayMs, this, [this, code]() { runBotTurn(code); });
+}
+
+//Führt den Zug des Bots aus: gleiche Regeln und gleicher Code wie bei menschlichen Spielern
+void Server::runBotTurn(const QString& code)
+{
+    GameState* g = getGame(code);
+    if (!g) return;
+    g->botTurnScheduled = false;
+    if (!g->started || g->finished || g->migrating || m_handingOver)
+        return;
+
+    const int seatIndex = g->currentPlayerIndex;
+    const PlayerSeat& seat = g->seats.value(seatIndex);
+    if (!seat.bot)
+        return;
+
+    if (seat.strongBot && g->seats.size() <= FastGame::MaxPlayers) {
+        // Suche läuft im Thread-Pool; bis das Ergebnis da ist, bleibt der Bot-Zug "geplant"
+        g->botTurnScheduled = true;
+        IsmctsConfig search;
+        search.budgetMs = m_config.strongBotBudgetMs;
+        search.threads = m_config.strongBotThreads;
+        IsmctsSearch::searchAsync(infoSetFor(*g, seatIndex), search, this,
+                                  [this, code, seatIndex](const IsmctsResult& result) {
+                                      finishStrongBotTurn(code, seatIndex, result);
+                                  });
+        return;
+    }
 
-    return QStringList{
-        // Rot
-        "Rot_1.jpg","Rot_2.jpg","Rot_3.jpg","Rot_4.jpg","Rot_5.jpg","Rot_6.jpg","Rot_7.jpg","Rot_8.jpg","Rot_9.jpg",
+    const BotMove move = heuristicBotMove(g, seatIndex);
+    applyBotMove(g, seatIndex, move.handIndex >= 0 ? seat.hand.at(move.handIndex) : QString(),
+                 QString(CardCatalog::colorName(move.chosenColor)));
+}
 
-        // Gruen
-        "Gruen_1.jpg","Gruen_2.jpg","Gruen_3.jpg","Gruen_4.jpg","Gruen_5.jpg","Gruen_6.jpg","Gruen_7.jpg","Gruen_8.jpg","Gruen_9.jpg",
+//Ergebnis der ISMCTS-Suche anwenden. Der Tisch kann sich inzwischen geändert haben, daher alles neu prüfen
+void Server::finishStrongBotTurn(const QString& code, int seatIndex, const IsmctsResult& result)
+{
+    GameState* g = getGame(code);
+    if (!g) return;
+    g->botTurnScheduled = false;
+    if (!g->started || g->finished || g->migrating || m_handingOver
+        || g->currentPlayerIndex != seatIndex || !g->seats.value(seatIndex).bot) {
+        scheduleBotTurn(g);
+        return;
+    }
 
-        // Blau
-        "Blau_1.jpg","Blau_2.jpg","Blau_3.jpg","Blau_4.jpg","Blau_5.jpg","Blau_6.jpg","Blau_7.jpg","Blau_8.jpg","Blau_9.jpg",
+    const QStringList& hand = g->seats[seatIndex].hand;
+    const QString card = result.move.card >= 0 ? QString(CardCatalog::name(result.move.card)) : QString();
+    if (result.iterations == 0 || (!card.isEmpty() && !hand.contains(card))) {
+        // Suche lieferte nichts Brauchbares: Heuristik übernimmt
+        const BotMove move = heuristicBotMove(g, seatIndex);
+        applyBotMove(g, seatIndex, move.handIndex >= 0 ? hand.at(move.handIndex) : QString(),
+                     QString(CardCatalog::colorName(move.chosenColor)));
+        return;
+    }
 
-        // Gelb
-        "Gelb_1.jpg","Gelb_2.jpg","Gelb_3.jpg","Gelb_4.jpg","Gelb_5.jpg","Gelb_6.jpg","Gelb_7.jpg","Gelb_8.jpg","Gelb_9.jpg",
+    const CardCatalog::Color color = CardCatalog::Color(result.move.color);
+    qInfo() << "[GAME]" << code << "strong bot" << seatIndex << "searched" << result.iterations << "iterations";
+    applyBotMove(g, seatIndex, card, QString(CardCatalog::colorName(color)));
+}
 
-        // Sperre
-        "Rot_Sperre.jpg","Gruen_Sperre.jpg","Blau_Sperre.jpg","Gelb_Sperre.jpg",
+BotMove Server::heuristicBotMove(const GameState* g, int seatIndex) const
+{
+    const int nextIndex = nextActiveSeat(g, seatIndex);
+    return BotPlayer::chooseMove(g->seats[seatIndex].hand,
+                                 g->discard.isEmpty() ? QStringView() : QStringView(g->discard.last()),
+                                 g->currentColor,
+                                 g->seats.value(nextIndex).hand.size());
+}
 
-        // Richtungswechsel
-        "Rot_Richtungswechsel.jpg","Gruen_Richtungswechsel.jpg",
-        "Blau_Richtungswechsel.jpg","Gelb_Richtungswechsel.jpg",
+//Legt die Karte (leer = ziehen); scheitert das, wird gezogen oder notfalls weitergegeben
+void Server::applyBotMove(GameState* g, int seatIndex, const QString& card, const QString& chosenColor)
+{
+    const QString code = g->code;
+    QString error;
+    bool ok = false;
+    if (!card.isEmpty())
+        ok = playCardForSeat(g, seatIndex, card, chosenColor, &error);
+    if (!ok)
+        ok = drawCardsForSeat(g, seatIndex, 1, &error);
+    if (!ok) {
+        // Weder legen noch ziehen möglich (Deck leer): Zug weitergeben, damit der Tisch nicht hängt
+        g->currentPlayerIndex = UnoRules::advanceIndex(seatIndex, 1, g->direction, g->seats.size());
+        skipAbandonedSeats(g);
+        sendStateUpdate(g);
+    }
+
+    scheduleBotTurn(getGame(code));
+}
 
-        // Spezialkarten
-        "Extra_Farbwechsel.jpg",
-        "Extra_4plus.jpg"
+//Entfernt ein beendetes Spiel, sobald kein Mensch mehr verbunden ist
+void Server::removeGameIfIdle(const QString& code)
+{
+    GameState* g = getGame(code);
+    if (!g || !g->finished)
+        return;
+    for (const PlayerSeat& seat : g->seats) {
+        if (seat.sock)
+            return;
+    }
+    removeGame(code);
+}
+
+//Setzt einen Spieler nach einem Verbindungsabbruch wieder auf seinen Platz. Erst kommen die verpassten
+//öffentlichen Events, danach ein kompakter Snapshot (resume_ok), der den Stand des Clients ersetzt.
+void Server::resumeSession(QTcpSocket* sock, const QString& token, quint64 lastSeq)
+{
+    if (m_socketToGame.contains(sock) || m_spectatorToGame.contains(sock) || m_matchmaker.contains(sock)) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Already in a game"}});
+        return;
+    }
+
+    const QString code = m_resumeTokens.value(token);
+    GameState* g = getGame(code);
+    if (!g) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Invalid resume token"}});
+        return;
+    }
+
+    int seatIndex = -1;
+    for (int i = 0; i < g->seats.size(); ++i) {
+        if (g->seats[i].resumeToken == token) {
+            seatIndex = i;
+            break;
+        }
+    }
+    if (seatIndex < 0 || g->seats[seatIndex].abandoned) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Seat expired"}});
+        return;
+    }
+
+    PlayerSeat& seat = g->seats[seatIndex];
+
+    // Alte Verbindung (z.B. halb offene TCP-Verbindung nach WLAN-Wechsel) wird ersetzt
+    if (QTcpSocket* old = seat.sock) {
+        m_socketToGame.remove(old);
+        if (g->host == old) g->host = sock;
+        auto connIt = m_connections.find(old);
+        if (connIt != m_connections.end())
+            connIt->closing = true;
+        QMetaObject::invokeMethod(old, [old]() { old->abort(); }, Qt::QueuedConnection);
+    }
+
+    seat.sock = sock;
+    seat.disconnectedAtMs = -1;
+    m_socketToGame.insert(sock, code);
+    if (!g->host) g->host = sock;
+
+    // Verpasste Events nur, wenn der Backlog lückenlos an lastSeq anschließt
+    if (!g->recentEvents.isEmpty() && g->recentEvents.first().first <= lastSeq + 1) {
+        for (const auto& ev : g->recentEvents) {
+            if (ev.first > lastSeq)
+                writePayload(sock, ev.second, false);
+        }
+    }
+
+    sendJson(sock, resumeSnapshot(g, seatIndex));
+
+    appendLog(g, "reconnect", seatIndex, "ok");
+    broadcast(g, QJsonObject{{"type","player_reconnected"},{"playerIndex",seatIndex}});
+    qInfo() << "[GAME]" << code << "player resumed seat" << seatIndex << "lastSeq=" << lastSeq;
+}
+
+//Kompletter Stand für einen Platz inkl. eigener Hand; ersetzt beim Client alles Bisherige
+QJsonObject Server::resumeSnapshot(GameState* g, int seatIndex) const
+{
+    QJsonArray handArr;
+    for (const QString& c : g->seats[seatIndex].hand)
+        handArr.append(c);
+
+    QJsonObject snapshot = publicState(g);
+    snapshot.insert("type", "resume_ok");
+    snapshot.insert("code", g->code);
+    snapshot.insert("players", g->seats.size());
+    snapshot.insert("yourIndex", seatIndex);
+    snapshot.insert("hand", handArr);
+    snapshot.insert("direction", g->direction);
+    snapshot.insert("seq", double(g->eventSeq));
+    return snapshot;
+}
+
+//Gibt reservierte Plätze frei, deren Frist abgelaufen ist. Bleibt höchstens ein Spieler übrig, hat er gewonnen
+void Server::expireReservedSeats()
+{
+    const qint64 now = m_clock.elapsed();
+    QStringList emptyGames;
+
+    for (auto it = m_games.begin(); it != m_games.end(); ++it) {
+        GameState* g = &it.value();
+        // Während einer Migration ist der Snapshot schon gemacht: Plätze nicht mehr verändern
+        if (!g->started || g->finished || g->migrating)
+            continue;
+
+        bool changed = false;
+        for (int i = 0; i < g->seats.size(); ++i) {
+            PlayerSeat& seat = g->seats[i];
+            if (seat.sock || seat.abandoned || seat.disconnectedAtMs < 0)
+                continue;
+            if (now - seat.disconnectedAtMs < m_config.seatGraceMs)
+                continue;
+
+            m_resumeTokens.remove(seat.resumeToken);
+            seat.resumeToken.clear();
+            changed = true;
+
+            // Ein Bot übernimmt den Platz samt Handkarten, damit der Tisch voll bleibt
+            if (m_config.botReplacesDisconnected) {
+                seat.bot = true;
+                seat.disconnectedAtMs = -1;
+                appendLog(g, "bot_takeover", i, "grace_expired");
+                broadcast(g, QJsonObject{{"type","player_replaced"},{"playerIndex",i}});
+                continue;
+            }
+
+            seat.abandoned = true;
+            if (g->pendingUnoPlayerIndex == i) {
+                g->pendingUnoPlayerIndex = -1;
+                g->pendingUnoDeclared = false;
+            }
+            appendLog(g, "left", i, "grace_expired");
+            broadcast(g, QJsonObject{{"type","player_left"},{"playerIndex",i}});
+        }
+        if (!changed)
+            continue;
+
+        const int active = activeSeatCount(g);
+        if (active == 0) {
+            emptyGames.append(g->code);
+            continue;
+        }
+
+        skipAbandonedSeats(g);
+        if (active == 1) {
+            g->finished = true;
+            appendLog(g, "win", g->currentPlayerIndex, "opponents_left");
+            broadcast(g, QJsonObject{{"type","game_finished"},
+                                     {"winnerIndex", g->currentPlayerIndex},
+                                     {"logCsv", g->logLines.join("\n")}});
+        }
+        sendStateUpdate(g);
+        scheduleBotTurn(g);
+    }
+
+    for (const QString& code : emptyGames)
+        removeGame(code);
+}
+
+//Entfernt ein Spiel samt Zuschauern und Resume-Tokens
+void Server::removeGame(const QString& code)
+{
+    GameState* g = getGame(code);
+    if (!g) return;
+
+    for (QTcpSocket* s : g->spectators.members()) {
+        m_spectatorToGame.remove(s);
+        sendJson(s, QJsonObject{{"type","error"},{"message","Game closed"}});
+    }
+    for (const PlayerSeat& seat : g->seats) {
+        m_resumeTokens.remove(seat.resumeToken);
+        if (seat.sock)
+            m_socketToGame.remove(seat.sock);
+    }
+    m_gamesWithSpectatorEvents.remove(code);
+    m_games.remove(code);
+}
+
+//Admin-Befehle nur mit passendem Token; einmal angemeldet gilt die ganze Verbindung als Admin
+bool Server::checkAdmin(QTcpSocket* sock, const QJsonObject& msg)
+{
+    auto it = m_connections.find(sock);
+    if (it == m_connections.end())
+        return false;
+    if (!it->admin && !m_config.adminToken.isEmpty() && msg.value("adminToken").toString() == m_config.adminToken)
+        it->admin = true;
+    if (!it->admin) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Not authorized"}});
+        return false;
+    }
+    return true;
+}
+
+//Friert das Spiel ein und schickt den Snapshot an den Zielserver. Erst nach import_ok werden die Clients umgeleitet
+void Server::migrateGame(QTcpSocket* sock, const QString& code, const QString& host, quint16 port)
+{
+    GameState* g = getGame(code);
+    if (!g) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Game not found"}});
+        return;
+    }
+    if (g->migrating) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Game is migrating"}});
+        return;
+    }
+    // Vor dem Start gibt es keine Resume-Tokens und der Snapshot kennt die Lobby nicht:
+    // umgeleitete Clients könnten ihren Platz auf dem Ziel nicht übernehmen
+    if (!g->started) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Game not started"}});
+        return;
+    }
+
+    g->migrating = true;
+    const QByteArray snapshot = GameSnapshot::encode(*g);
+    qInfo() << "[GAME]" << code << "migrating to" << host << port << "snapshot=" << snapshot.size() << "bytes";
+
+    QPointer<QTcpSocket> requester(sock);
+    auto* link = new QTcpSocket(this);
+    auto* buffer = new QByteArray;
+    auto done = [this, link, buffer, requester, code, host, port](bool ok, const QString& reason) {
+        if (link->property("done").toBool())
+            return;
+        link->setProperty("done", true);
+        delete buffer;
+        link->disconnect(this);
+        link->deleteLater();
+
+        if (ok) {
+            finishMigration(code, host, port);
+        } else {
+            qInfo() << "[GAME]" << code << "migration failed:" << reason;
+            abortMigration(code);
+        }
+        if (requester) {
+            sendJson(requester, ok ? QJsonObject{{"type","migrate_ok"},{"code",code}}
+                                   : QJsonObject{{"type","error"},{"message","Migration failed: " + reason}});
+        }
     };
+
+    // "code" in beiden Nachrichten, damit ein Router am Ziel zum richtigen Worker weiterreicht
+    connect(link, &QTcpSocket::connected, this, [this, link, snapshot, code]() {
+        QJsonObject import{{"type","import_game"},{"code",code},{"adminToken",m_config.adminToken},
+                           {"snapshot",QString::fromLatin1(snapshot.toBase64())}};
+        link->write(encodeJson(QJsonObject{{"type","admin_hello"},{"code",code},{"adminToken",m_config.adminToken}}));
+        link->write(encodeJson(import));
+    });
+    connect(link, &QTcpSocket::readyRead, this, [link, buffer, done]() {
+        *buffer += link->readAll();
+        int nl;
+        while ((nl = buffer->indexOf('\n')) >= 0) {
+            const QJsonObject reply = QJsonDocument::fromJson(buffer->left(nl)).object();
+            buffer->remove(0, nl + 1);
+            const QString type = reply.value("type").toString();
+            if (type == "import_ok") {
+                done(true, QString());
+                return;
+            }
+            if (type == "error") {
+                done(false, reply.value("message").toString());
+                return;
+            }
+        }
+    });
+    connect(link, &QTcpSocket::errorOccurred, this, [link, done](QAbstractSocket::SocketError) {
+        done(false, link->errorString());
+    });
+    QTimer::singleShot(m_config.migrationTimeoutMs, link, [done]() { done(false, "Timeout"); });
+
+    link->connectToHost(host, port);
+}
+
+//Zielserver hat das Spiel: alle Spieler (mit Token) und Zuschauer dorthin umleiten und lokal aufräumen
+void Server::finishMigration(const QString& code, const QString& host, quint16 port)
+{
+    GameState* g = getGame(code);
+    if (!g) return;
+
+    QList<QTcpSocket*> redirected;
+    for (const PlayerSeat& seat : g->seats) {
+        if (!seat.sock)
+            continue;
+        sendJson(seat.sock, QJsonObject{{"type","redirect"},{"host",host},{"port",port},
+                                        {"code",code},{"token",seat.resumeToken}});
+        redirected.append(seat.sock);
+    }
+    for (QTcpSocket* s : g->spectators.members()) {
+        sendJson(s, QJsonObject{{"type","redirect"},{"host",host},{"port",port},{"code",code}});
+        m_spectatorToGame.remove(s);
+        redirected.append(s);
+    }
+    g->spectators = BroadcastGroup();
+
+    removeGame(code);
+    ++m_metrics.gamesMigratedOut;
+    qInfo() << "[GAME]" << code << "migrated, redirected" << redirected.size() << "clients";
+
+    // Schreibpuffer noch leeren lassen, dann trennen
+    for (QTcpSocket* s : std::as_const(redirected)) {
+        auto it = m_connections.find(s);
+        if (it != m_connections.end())
+            it->closing = true;
+        QMetaObject::invokeMethod(s, [s]() { s->disconnectFromHost(); }, Qt::QueuedConnection);
+    }
+}
+
+void Server::abortMigration(const QString& code)
+{
+    GameState* g = getGame(code);
+    if (!g) return;
+    g->migrating = false;
+    scheduleBotTurn(g);
+}
+
+//Übernimmt ein migriertes Spiel. Alle Plätze sind reserviert, bis die Clients per resume zurückkommen
+void Server::importGame(QTcpSocket* sock, const QByteArray& snapshot)
+{
+    GameState imported;
+    QString error;
+    if (!GameSnapshot::decode(snapshot, &imported, &error)) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message",error}});
+        return;
+    }
+    if (imported.code.isEmpty() || m_games.contains(imported.code)) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Code in use"}});
+        return;
+    }
+
+    GameState* g = installGame(imported);
+    ++m_metrics.gamesMigratedIn;
+
+    sendJson(sock, QJsonObject{{"type","import_ok"},{"code",g->code}});
+    qInfo() << "[GAME]" << g->code << "imported, seats=" << g->seats.size();
+    scheduleBotTurn(g);
+}
+
+//Legt ein Spiel aus einem Snapshot an; Spielerplätze sind reserviert, bis jemand sie übernimmt
+GameState* Server::installGame(const GameState& game)
+{
+    const QString code = game.code;
+    GameState& g = m_games[code];
+    g = game;
+    const qint64 now = m_clock.elapsed();
+    for (PlayerSeat& seat : g.seats) {
+        seat.sock = nullptr;
+        if (!seat.bot && !seat.abandoned)
+            seat.disconnectedAtMs = now;
+        if (!seat.resumeToken.isEmpty())
+            m_resumeTokens.insert(seat.resumeToken, code);
+    }
+    return &g;
+}
+
+//Neuer Prozess beim Hot-Restart: übernimmt Listening-Socket, Spiele und Verbindungen vom Vorgänger
+void Server::takeOver()
+{
+    HotRestart::State state;
+    QString error;
+    if (!HotRestart::receive(m_config.takeoverFrom, 10000, &state, &error)) {
+        qFatal("Takeover failed: %s", qPrintable(error));
+    }
+    if (!m_server.setSocketDescriptor(state.listenFd)) {
+        qFatal("Takeover: listening socket unusable");
+    }
+
+    for (const QByteArray& snapshot : std::as_const(state.snapshots)) {
+        GameState g;
+        if (GameSnapshot::decode(snapshot, &g, &error))
+            installGame(g);
+        else
+            qWarning() << "[GAME] takeover: snapshot dropped:" << error;
+    }
+
+    QList<QTcpSocket*> adopted;
+    QList<QTcpSocket*> writeLost;
+    for (const HotRestart::Connection& c : std::as_const(state.connections)) {
+        auto* sock = new QTcpSocket(this);
+        if (!sock->setSocketDescriptor(c.fd)) {
+            delete sock;
+            FdHandoff::closeFd(c.fd);
+            continue;
+        }
+        setupConnection(sock);
+        m_connections[sock].inBuffer = c.inBuffer;
+
+        GameState* g = getGame(c.code);
+        if (g && c.spectator) {
+            g->spectators.add(sock);
+            m_spectatorToGame.insert(sock, c.code);
+        } else if (g && c.seatIndex >= 0 && c.seatIndex < g->seats.size()) {
+            PlayerSeat& seat = g->seats[c.seatIndex];
+            seat.sock = sock;
+            seat.disconnectedAtMs = -1;
+            m_socketToGame.insert(sock, c.code);
+            if (c.host)
+                g->host = sock;
+        }
+        adopted.append(sock);
+        if (c.writeLost)
+            writeLost.append(sock);
+    }
+
+    qInfo() << "[NET] Took over port" << m_server.serverPort() << "with" << m_games.size() << "games and"
+            << adopted.size() << "connections";
+
+    // Erst wenn alles verdrahtet ist: gepufferte Eingaben verarbeiten, frischen Stand schicken, Bots anstoßen
+    QMetaObject::invokeMethod(this, [this, adopted, writeLost]() {
+        // Beim Vorgänger blieb Ungesendetes liegen: "\n" beendet eine halb geschriebene Zeile (der Client
+        // verwirft sie), danach bekommen Spieler ihren kompletten Stand samt Hand wie nach einem Resume
+        for (QTcpSocket* sock : writeLost) {
+            sock->write("\n");
+            GameState* g = getGame(m_socketToGame.value(sock));
+            const int seatIndex = g ? indexOfPlayer(g, sock) : -1;
+            if (g && g->started && seatIndex >= 0)
+                sendJson(sock, resumeSnapshot(g, seatIndex));
+        }
+        for (auto it = m_games.begin(); it != m_games.end(); ++it) {
+            if (it->started && !it->finished)
+                sendStateUpdate(&it.value());
+            scheduleBotTurn(&it.value());
+        }
+        for (QTcpSocket* sock : adopted)
+            onReadyRead(sock);
+    }, Qt::QueuedConnection);
+}
+
+//Alter Prozess: ein Nachfolger will übernehmen. Annahme und Spielbetrieb anhalten, Schreibpuffer leerlaufen lassen
+void Server::beginHandOver(int channel)
+{
+    qInfo() << "[NET] hot restart requested, draining" << m_connections.size() << "connections";
+    m_handingOver = true;
+    m_server.pauseAccepting();
+    m_housekeepingTimer.stop();
+    m_matchmakingTimer.stop();
+    m_spectatorTimer.stop();
+
+    QElapsedTimer draining;
+    draining.start();
+    auto* drainTimer = new QTimer(this);
+    connect(drainTimer, &QTimer::timeout, this, [this, drainTimer, draining, channel]() {
+        bool drained = true;
+        for (auto it = m_connections.cbegin(); it != m_connections.cend() && drained; ++it)
+            drained = it.key()->bytesToWrite() == 0;
+        if (!drained && draining.elapsed() < m_config.handoverDrainMs)
+            return;
+        drainTimer->stop();
+        drainTimer->deleteLater();
+        completeHandOver(channel);
+    });
+    drainTimer->start(10);
+}
+
+//Übergibt alles in einem Rutsch (ohne Event-Loop dazwischen, damit Qt nichts mehr nachliest) und beendet den Prozess
+void Server::completeHandOver(int channel)
+{
+    HotRestart::State state;
+    state.listenFd = int(m_server.socketDescriptor());
+    for (auto it = m_games.cbegin(); it != m_games.cend(); ++it)
+        state.snapshots.append(GameSnapshot::encode(it.value()));
+
+    for (auto it = m_connections.begin(); it != m_connections.end(); ++it) {
+        if (it->closing)
+            continue;
+        QTcpSocket* sock = it.key();
+        HotRestart::Connection c;
+        c.fd = int(sock->socketDescriptor());
+        c.inBuffer = it->inBuffer + sock->readAll();
+        // Qt-Schreibpuffer geht mit dem Prozess verloren; der Nachfolger schickt dafür einen frischen Stand
+        c.writeLost = sock->bytesToWrite() > 0;
+        if (GameState* g = getGame(m_socketToGame.value(sock))) {
+            c.code = g->code;
+            c.seatIndex = indexOfPlayer(g, sock);
+            c.host = g->host == sock;
+        } else if (m_spectatorToGame.contains(sock)) {
+            c.code = m_spectatorToGame.value(sock);
+            c.spectator = true;
+        }
+        state.connections.append(c);
+    }
+
+    const bool ok = HotRestart::send(channel, state);
+    FdHandoff::closeFd(channel);
+    if (!ok) {
+        qWarning() << "[NET] hot restart failed, continuing to serve";
+        m_handingOver = false;
+        m_server.resumeAccepting();
+        m_housekeepingTimer.start(1000);
+        m_matchmakingTimer.start(m_config.matchmakingIntervalMs);
+        m_hotRestart.rearm();
+        for (auto it = m_games.begin(); it != m_games.end(); ++it)
+            scheduleBotTurn(&it.value());
+        for (QTcpSocket* sock : m_connections.keys())
+            QMetaObject::invokeMethod(this, [this, sock]() { onReadyRead(sock); }, Qt::QueuedConnection);
+        return;
+    }
+
+    // Die Deskriptoren leben im Nachfolger weiter; unser close() beendet keine TCP-Verbindung
+    for (QTcpSocket* sock : m_connections.keys()) {
+        disconnect(sock, nullptr, this, nullptr);
+        sock->abort();
+        sock->deleteLater();
+    }
+    qInfo() << "[NET] handed over" << state.snapshots.size() << "games and" << state.connections.size()
+            << "connections, exiting";
+    m_connections.clear();
+    m_server.close();
+    QCoreApplication::quit();
+}
+
+//Nimmt einen Zuschauer auf. Er bekommt den öffentlichen Stand und danach card_played, state_update und game_finished,
+//alles mit derselben Verzögerung: spectate_ok läuft durch den Verzögerungs-Ring wie jedes andere Event
+void Server::spectateGame(QTcpSocket* sock, const QString& code)
+{
+    if (m_socketToGame.contains(sock) || m_spectatorToGame.contains(sock) || m_matchmaker.contains(sock)) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Already in a game"}});
+        return;
+    }
+
+    GameState* g = getGame(code);
+    if (!g) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Game not found"}});
+        return;
+    }
+
+    g->spectators.add(sock);
+    m_spectatorToGame.insert(sock, code);
+
+    QJsonObject ok = publicState(g);
+    ok.insert("type", "spectate_ok");
+    ok.insert("code", code);
+    ok.insert("players", g->seats.size());
+    ok.insert("started", g->started);
+    ok.insert("delayMs", m_config.spectatorDelayMs);
+    publishToSpectators(g, encodeJson(ok), false, sock);
+
+    qInfo() << "[GAME]" << code << "spectator joined, total=" << g->spectators.size();
+}
+
+//Misch das Kartendeck durch
+void Server::shuffle(QStringList& list) const
+{
+    for (int i = list.size() - 1; i > 0; --i) {
+        const int j = QRandomGenerator::global()->bounded(i + 1);
+        list.swapItemsAt(i, j);
+    }
+}
+
+//Liste, welche Karten es alle gibt.
+const QStringList& Server::fullDeck()
+{
+    // Die Tabelle erzeugt der Build aus assets/images/cards (cardindex.h). Die Strings werden
+    // einmal gebaut; jedes Spiel bekommt eine implizit geteilte Kopie, erst shuffle() kopiert
+    // die Liste (nicht die Strings).
+    static const QStringList deck = [] {
+        QStringList d;
+        d.reserve(CardCatalog::CardCount);
+        for (int i = 0; i < CardCatalog::CardCount; ++i)
+            d.append(QString(CardCatalog::name(i)));
+        return d;
+    }();
+    return deck;
 }
 
 //Startet das Spiel, sendet den Clients alle Infos.
@@ -528,21 +1832,36 @@ void Server::startGame(QTcpSocket* sock, const QString& code)
         return;
     }
 
-    g->deck = buildDeckFromStaticList();
-    if (g->deck.size() < (g->players.size() * 6 + 1)) {
-        sendJson(sock, QJsonObject{{"type","error"},{"message","Not enough cards in deck list"}});
-        return;
+    QString error;
+    if (!beginGame(g, &error))
+        sendJson(sock, QJsonObject{{"type","error"},{"message",error}});
+}
+
+//Mischt, teilt aus und schickt jedem Spieler sein game_init (gemeinsam für start_game und Matchmaking)
+bool Server::beginGame(GameState* g, QString* error)
+{
+    const QString code = g->code;
+
+    g->deck = fullDeck();
+    if (g->deck.size() < (g->seats.size() * 6 + 1)) {
+        if (error) *error = "Not enough cards in deck list";
+        return false;
     }
     shuffle(g->deck);
 
-    g->hands.clear();
     g->discard.clear();
 
-    for (QTcpSocket* p : g->players) {
-        QStringList hand;
+    for (PlayerSeat& seat : g->seats) {
+        seat.hand.clear();
         for (int i = 0; i < 6; ++i)
-            hand.append(g->deck.takeLast());
-        g->hands.insert(p, hand);
+            seat.hand.append(g->deck.takeLast());
+
+        // Zufälliges Token, mit dem sich der Spieler nach einem Abbruch wieder auf seinen Platz setzt
+        m_resumeTokens.remove(seat.resumeToken);
+        // Präfix "CODE." damit der Router ein resume ohne Zustand zum richtigen Worker schickt
+        seat.resumeToken = code + '.' + QString::number(QRandomGenerator::system()->generate64(), 16)
+                           + QString::number(QRandomGenerator::system()->generate64(), 16);
+        m_resumeTokens.insert(seat.resumeToken, code);
     }
 
     g->discard.append(g->deck.takeLast());
@@ -555,30 +1874,25 @@ void Server::startGame(QTcpSocket* sock, const QString& code)
     g->logLines.clear();
     g->logLines.append("timestamp,event,playerIndex,detail");
 
-    const CardInfo topInfo = parseCardInfo(g->discard.last());
-    if (topInfo.isWild) {
-        g->currentColor = "Rot";
-    } else {
-        g->currentColor = topInfo.color;
-    }
+    g->currentColor = QString(CardCatalog::colorName(UnoRules::startColor(CardCatalog::indexOf(g->discard.last()))));
     appendLog(g, "start", -1, QString("discard=%1").arg(g->discard.last()));
 
-    const int players = g->players.size();
+    const int players = g->seats.size();
     const QString discardTop = g->discard.last();
     const int drawCount = g->deck.size();
     QJsonArray handCounts;
-    for (QTcpSocket* p : g->players)
-        handCounts.append(g->hands.value(p).size());
+    for (const PlayerSeat& seat : g->seats)
+        handCounts.append(seat.hand.size());
 
     qInfo() << "[GAME]" << code << "STARTED players=" << players
             << "discardTop=" << discardTop
             << "drawCount=" << drawCount;
 
-    for (int i = 0; i < g->players.size(); ++i) {
-        QTcpSocket* p = g->players[i];
+    for (int i = 0; i < g->seats.size(); ++i) {
+        const PlayerSeat& seat = g->seats[i];
 
         QJsonArray handArr;
-        for (const QString& c : g->hands.value(p))
+        for (const QString& c : seat.hand)
             handArr.append(c);
 
         QJsonObject init{
@@ -592,68 +1906,162 @@ void Server::startGame(QTcpSocket* sock, const QString& code)
             {"currentPlayerIndex",g->currentPlayerIndex},
             {"handCounts",handCounts},
             {"currentColor", g->currentColor},
-            {"finished", g->finished}
+            {"direction", g->direction},
+            {"finished", g->finished},
+            {"resumeToken", seat.resumeToken},
+            {"seq", double(g->eventSeq)}
         };
 
-        sendJson(p, init);
+        sendJson(seat.sock, init);
+    }
+
+    // Zuschauer bekommen statt game_init nur den öffentlichen Stand
+    QJsonObject state = publicState(g);
+    state.insert("type", "state_update");
+    state.insert("players", players);
+    publishToSpectators(g, encodeJson(state), true);
+
+    scheduleBotTurn(g);
+    return true;
+}
+
+//Reiht einen Spieler in die Matchmaking-Warteschlange ein
+void Server::queueJoin(QTcpSocket* sock, int tableSize, int rating)
+{
+    if (m_socketToGame.contains(sock) || m_spectatorToGame.contains(sock) || m_matchmaker.contains(sock)) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Already in a game"}});
+        return;
+    }
+
+    // Jeder Spieler braucht 6 Karten plus eine Startkarte auf der Ablage
+    constexpr int maxPlayers = (CardCatalog::CardCount - 1) / 6;
+    if (tableSize < 2 || tableSize > maxPlayers) {
+        sendJson(sock, QJsonObject{{"type","error"},{"message","Invalid table size"}});
+        return;
+    }
+
+    m_matchmaker.enqueue(sock, tableSize, rating);
+    sendJson(sock, QJsonObject{{"type","queue_ok"},{"size",tableSize},{"queued",m_matchmaker.queuedCount()}});
+}
+
+//Bildet im Batch volle Tische aus der Warteschlange und startet sie direkt
+void Server::runMatchmaking()
+{
+    if (!m_matchmaker.hasReadyTables())
+        return;
+
+    const QList<QList<QTcpSocket*>> tables = m_matchmaker.formTables(m_config.matchmakingBatchSize);
+    for (const QList<QTcpSocket*>& table : tables) {
+        const QString code = allocateCode();
+        if (code.isEmpty()) {
+            for (QTcpSocket* p : table)
+                sendJson(p, QJsonObject{{"type","error"},{"message","Could not create code"}});
+            continue;
+        }
+
+        GameState g;
+        g.code = code;
+        g.host = table.first();
+        for (QTcpSocket* p : table) {
+            PlayerSeat seat;
+            seat.sock = p;
+            g.seats.append(seat);
+        }
+        m_games.insert(code, g);
+
+        for (QTcpSocket* p : table) {
+            m_socketToGame.insert(p, code);
+            sendJson(p, QJsonObject{{"type","match_found"},{"code",code},{"players",table.size()}});
+        }
+
+        QString error;
+        if (!beginGame(getGame(code), &error)) {
+            for (QTcpSocket* p : table)
+                sendJson(p, QJsonObject{{"type","error"},{"message",error}});
+        }
+        qInfo() << "[MATCH]" << code << "formed table size=" << table.size();
     }
+
+    if (!tables.isEmpty())
+        qInfo() << "[MATCH] started" << tables.size() << "tables, still queued=" << m_matchmaker.queuedCount();
 }
 
 //wenn eine Karte gespielt wird, wird hier die Karte ausgelesen und die Infos an die Clients gesendet
-void Server::playCard(QTcpSocket* sock, const QString& card, const QString& chosenColor)
+void Server::playCard(QTcpSocket* sock, const QString& card, const QString& chosenColor, qint64 clientSeq)
 {
+    // Abgelehnte Züge tragen die clientSeq, damit der Client genau diese Vorhersage zurücknimmt
+    auto reject = [this, sock, clientSeq](const QString& message) {
+        QJsonObject err{{"type","error"},{"message",message}};
+        if (clientSeq >= 0)
+            err.insert("clientSeq", double(clientSeq));
+        sendJson(sock, err);
+    };
+
     const QString code = m_socketToGame.value(sock);
     if (code.isEmpty()) {
-        sendJson(sock, QJsonObject{{"type","error"},{"message","Not in a game"}});
+        reject("Not in a game");
         return;
     }
 
     GameState* g = getGame(code);
     if (!g || !g->started) {
-        sendJson(sock, QJsonObject{{"type","error"},{"message","Game not started"}});
+        reject("Game not started");
         return;
     }
     if (g->finished) {
-        sendJson(sock, QJsonObject{{"type","error"},{"message","Game finished"}});
+        reject("Game finished");
         return;
     }
 
     const int playerIndex = indexOfPlayer(g, sock);
     if (playerIndex < 0) {
-        sendJson(sock, QJsonObject{{"type","error"},{"message","Not a player"}});
+        reject("Not a player");
         return;
     }
 
     if (playerIndex != g->currentPlayerIndex) {
-        sendJson(sock, QJsonObject{{"type","error"},{"message","Not your turn"}});
+        reject("Not your turn");
         return;
     }
 
+    QString error;
+    if (!playCardForSeat(g, playerIndex, card, chosenColor, &error)) {
+        reject(error);
+        return;
+    }
+    scheduleBotTurn(g);
+}
+
+//Legt eine Karte für den Platz, der am Zug ist, und wendet die Sonderkarten an (gemeinsam für Spieler und Bots)
+bool Server::playCardForSeat(GameState* g, int playerIndex, const QString& card, const QString& chosenColor, QString* error)
+{
     applyUnoPenaltyIfNeeded(g, g->currentPlayerIndex);
 
     if (!isCardLegal(card, g->discard.isEmpty() ? QString() : g->discard.last(), g->currentColor)) {
-        sendJson(sock, QJsonObject{{"type","error"},{"message","Illegal card"}});
-        return;
+        if (error) *error = "Illegal card";
+        return false;
     }
 
-    const CardInfo playInfo = parseCardInfo(card);
-    if (playInfo.isWild && chosenColor.isEmpty()) {
-        sendJson(sock, QJsonObject{{"type","error"},{"message","Missing chosen color"}});
-        return;
+    const int cardIndex = CardCatalog::indexOf(card);
+    if (cardIndex < 0) {
+        if (error) *error = "Unknown card";
+        return false;
+    }
+    const bool wild = UnoRules::needsChosenColor(cardIndex);
+    if (wild && chosenColor.isEmpty()) {
+        if (error) *error = "Missing chosen color";
+        return false;
     }
 
-    if (playInfo.isWild) {
-        const QString upper = chosenColor.trimmed();
-        if (upper != "Rot" && upper != "Gruen" && upper != "Blau" && upper != "Gelb") {
-            sendJson(sock, QJsonObject{{"type","error"},{"message","Invalid color"}});
-            return;
-        }
+    if (wild && !UnoRules::isPlayableColor(CardCatalog::colorFromName(chosenColor.trimmed()))) {
+        if (error) *error = "Invalid color";
+        return false;
     }
 
-    QStringList& hand = g->hands[sock];
+    QStringList& hand = g->seats[playerIndex].hand;
     if (!hand.removeOne(card)) {
-        sendJson(sock, QJsonObject{{"type","error"},{"message","Card not in hand"}});
-        return;
+        if (error) *error = "Card not in hand";
+        return false;
     }
 
     if (g->pendingUnoPlayerIndex == playerIndex) {
@@ -663,34 +2071,27 @@ void Server::playCard(QTcpSocket* sock, const QString& card, const QString& chos
 
     g->discard.append(card);
 
-    if (playInfo.isWild) {
+    if (wild) {
         g->currentColor = chosenColor.trimmed();
     } else {
-        g->currentColor = playInfo.color;
+        g->currentColor = QString(CardCatalog::colorName(CardCatalog::card(cardIndex).color));
     }
 
-    const int playerCount = g->players.size();
+    // Sonderkarten: gleiche Regeln wie FastGame, siehe UnoRules::effectOf. Gezählt werden nur
+    // Plätze, die noch im Spiel sind: verlassene Plätze ziehen nicht und werden nicht "gesperrt"
+    const UnoRules::PlayEffect effect = UnoRules::effectOf(cardIndex, activeSeatCount(g));
     QStringList drawnCards;
     int drawnByIndex = -1;
-    if (playInfo.isWild && playInfo.value == "4plus") {
-        const int targetIndex = advanceIndex(g->currentPlayerIndex, 1, g->direction, playerCount);
-        QTcpSocket* targetSock = g->players[targetIndex];
+    if (effect.reverse)
+        g->direction = -g->direction;
+    if (effect.drawCount > 0) {
+        const int targetIndex = nextActiveSeat(g, g->currentPlayerIndex);
         refillDeck(g);
-        drawnCards = drawCardsToPlayer(g, targetSock, 4);
+        drawnCards = drawCardsToPlayer(g, targetIndex, effect.drawCount);
         drawnByIndex = targetIndex;
-        g->currentPlayerIndex = advanceIndex(g->currentPlayerIndex, 2, g->direction, playerCount);
-    } else if (playInfo.value == "Sperre") {
-        g->currentPlayerIndex = advanceIndex(g->currentPlayerIndex, 2, g->direction, playerCount);
-    } else if (playInfo.value == "Richtungswechsel") {
-        g->direction = -g->direction;
-        if (playerCount == 2) {
-            g->currentPlayerIndex = advanceIndex(g->currentPlayerIndex, 2, g->direction, playerCount);
-        } else {
-            g->currentPlayerIndex = advanceIndex(g->currentPlayerIndex, 1, g->direction, playerCount);
-        }
-    } else {
-        g->currentPlayerIndex = advanceIndex(g->currentPlayerIndex, 1, g->direction, playerCount);
     }
+    for (int step = 0; step < effect.advanceSteps; ++step)
+        g->currentPlayerIndex = nextActiveSeat(g, g->currentPlayerIndex);
 
     appendLog(g, "play", playerIndex, QString("%1|color=%2").arg(card, g->currentColor));
 
@@ -700,11 +2101,10 @@ void Server::playCard(QTcpSocket* sock, const QString& card, const QString& chos
         {"card", card}
     };
 
-    for (QTcpSocket* p : g->players)
-        sendJson(p, played);
+    broadcast(g, played);
 
     if (!drawnCards.isEmpty() && drawnByIndex >= 0) {
-        QTcpSocket* targetSock = g->players[drawnByIndex];
+        QTcpSocket* targetSock = g->seats[drawnByIndex].sock;
         QJsonArray cardsArr;
         for (const QString& c : drawnCards)
             cardsArr.append(c);
@@ -721,6 +2121,12 @@ void Server::playCard(QTcpSocket* sock, const QString& card, const QString& chos
         g->pendingUnoPlayerIndex = playerIndex;
         g->pendingUnoDeclared = false;
         appendLog(g, "uno_pending", playerIndex, "needs_declare");
+
+        // Bots vergessen UNO nie
+        if (g->seats[playerIndex].bot) {
+            g->pendingUnoDeclared = true;
+            appendLog(g, "uno_declared", playerIndex, "bot");
+        }
     }
 
     if (hand.isEmpty()) {
@@ -731,13 +2137,17 @@ void Server::playCard(QTcpSocket* sock, const QString& card, const QString& chos
             {"winnerIndex", playerIndex},
             {"logCsv", g->logLines.join("\n")}
         };
-        for (QTcpSocket* p : g->players)
-            sendJson(p, finished);
+        broadcast(g, finished);
+
+        // Reine Bot-Tische (z.B. Lasttests) werden nach dem Ende direkt aufgeräumt
+        const QString code = g->code;
+        QTimer::singleShot(0, this, [this, code]() { removeGameIfIdle(code); });
     }
 
     sendStateUpdate(g, card, playerIndex);
 
-    qInfo() << "[GAME]" << code << "play_card player=" << playerIndex << "card=" << card;
+    qInfo() << "[GAME]" << g->code << "play_card player=" << playerIndex << "card=" << card;
+    return true;
 }
 
 // Wenn der Client Uno deklariet, wird es hier vermerkt, damit er nicht bestraft wird,
@@ -4,13 +4,40 @@
 #include <QTcpServer>
 #include <QTcpSocket>
 #include <QHash>
+#include <QJsonArray>
 #include <QJsonObject>
 #include <QStringList>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QSet>
+
+#include "botplayer.h"
+#include "broadcastgroup.h"
+#include "fdhandoff.h"
+#include "hashring.h"
+#include "hotrestart.h"
+#include "ismcts.h"
+#include "latencyhistogram.h"
+#include "matchmaker.h"
+#include "serverconfig.h"
+#include "tokenbucket.h"
+
+// Fester Sitzplatz eines Spielers. Der Index in GameState::seats ist yourIndex und bleibt
+// gleich, auch wenn die Verbindung kurz weg ist (der Platz wird für die Frist reserviert).
+struct PlayerSeat {
+    QTcpSocket* sock = nullptr;                 // nullptr = gerade nicht verbunden
+    QStringList hand;
+    QString resumeToken;
+    qint64 disconnectedAtMs = -1;
+    bool abandoned = false;                     // Frist abgelaufen, Platz wird übersprungen
+    bool bot = false;                           // Server-Bot (vom Host hinzugefügt oder Ersatz)
+    bool strongBot = false;                     // Bot sucht per ISMCTS statt mit der Heuristik
+};
 
 struct GameState {
     QString code;
     QTcpSocket* host = nullptr;
-    QList<QTcpSocket*> players;                 // Reihenfolge = yourIndex
+    QList<PlayerSeat> seats;                    // Reihenfolge = yourIndex
     bool started = false;
     int currentPlayerIndex = 0;
     int direction = 1;
@@ -22,47 +49,164 @@ struct GameState {
 
     QStringList deck;                           // draw pile (oben = last)
     QStringList discard;                        // discard pile (oben = last)
-    QHash<QTcpSocket*, QStringList> hands;      // Handkarten je Spieler
+
+    quint64 eventSeq = 0;                       // fortlaufende Nummer der öffentlichen Events
+    QList<QPair<quint64, QByteArray>> recentEvents; // letzte Events für Reconnects
+    bool botTurnScheduled = false;
+    bool migrating = false;                     // Snapshot ist unterwegs, Züge werden abgelehnt
+
+    BroadcastGroup spectators;                  // Zuschauer, bekommen nur öffentliche Events
+};
+
+// Zustand pro Verbindung (Eingangspuffer + Backpressure beim Senden)
+struct ConnectionState {
+    QString peerIp;
+    QByteArray inBuffer;
+    int scanFrom = 0;                           // ab hier wurde noch nicht nach '\n' gesucht
+    TokenBucket rateLimit;
+    bool throttled = false;                     // Lesen pausiert wegen Rate-Limit
+    QByteArray pendingStateUpdate;              // neuestes zurückgehaltenes state_update
+    bool slow = false;                          // Schreibpuffer über der High-Watermark
+    bool closing = false;                       // Trennung ist bereits angestoßen
+    bool admin = false;                         // per adminToken angemeldet (Migration)
+    QElapsedTimer slowSince;
+
+    // Latenz: offener ping (id + Sendezeit) und die Messwerte dieser Verbindung
+    quint32 pingId = 0;
+    qint64 pingSentNs = -1;                     // m_clock, -1 = kein ping offen
+    qint64 pingSentWallMs = 0;
+    double smoothedRttMs = -1.0;                // gleitender Mittelwert wie bei TCP (1/8)
+    qint64 clockOffsetMs = 0;                   // Client-Uhr minus Server-Uhr
+    LatencyHistogram rtt;
+};
+
+// Gemeinsames Rate-Limit aller Verbindungen einer IP
+struct IpState {
+    TokenBucket rateLimit;
+    int connections = 0;
+};
+
+struct ServerMetrics {
+    quint64 droppedStateUpdates = 0;
+    quint64 slowConsumerDisconnects = 0;
+    quint64 throttledReads = 0;
+    quint64 oversizedFrames = 0;
+    quint64 discardedBytes = 0;
+    quint64 spectatorEventsDropped = 0;
+    quint64 adoptedConnections = 0;             // vom Router übergebene Verbindungen
+    quint64 gamesMigratedOut = 0;
+    quint64 gamesMigratedIn = 0;
+    LatencyHistogram rtt;                       // Netzwerk-RTT aller Verbindungen
+    LatencyHistogram processing;                // Parsen + handleMessage pro Nachricht
 };
 
 class Server : public QObject {
     Q_OBJECT
 public:
-    explicit Server(QObject* parent = nullptr);
+    explicit Server(const ServerConfig& config = ServerConfig(), QObject* parent = nullptr);
 
 private:
     void onNewConnection();
+    void setupConnection(QTcpSocket* sock);
+    void adoptConnection(qintptr fd, const QByteArray& initialBytes);
     void onReadyRead(QTcpSocket* sock);
     void onDisconnected(QTcpSocket* sock);
+    void onBytesWritten(QTcpSocket* sock);
+    bool takeMessageToken(QTcpSocket* sock, ConnectionState& conn);
+    void resumeReading(QTcpSocket* sock);
+    void rejectOversizedFrame(QTcpSocket* sock, ConnectionState& conn);
+    void checkSlowConsumers();
+    void expireReservedSeats();
+    void sendPings();
+    void handlePong(QTcpSocket* sock, const QJsonObject& msg);
 
     void handleMessage(QTcpSocket* sock, const QJsonObject& msg);
     void sendJson(QTcpSocket* sock, const QJsonObject& obj);
+    void writePayload(QTcpSocket* sock, const QByteArray& payload, bool supersedable);
+    void dropConnection(QTcpSocket* sock, ConnectionState& conn, const char* reason);
+    QJsonObject metricsJson() const;
 
     QString createCode() const;
+    QString allocateCode() const;
+    bool ownsCode(const QString& code) const;
+    QJsonArray foreignGames() const;
+    void setWorkerCount(QTcpSocket* sock, int count);
+    bool redirectIfForeign(QTcpSocket* sock, const QString& code, const QJsonObject& msg);
     GameState* getGame(const QString& code);
 
     void createGame(QTcpSocket* hostSock);
     void joinGame(QTcpSocket* sock, const QString& code);
     void startGame(QTcpSocket* sock, const QString& code);
+    bool beginGame(GameState* g, QString* error);
+    void queueJoin(QTcpSocket* sock, int tableSize, int rating);
+    void runMatchmaking();
     void drawCards(QTcpSocket* sock, int count);
-    void playCard(QTcpSocket* sock, const QString& card, const QString& chosenColor);
+    void playCard(QTcpSocket* sock, const QString& card, const QString& chosenColor, qint64 clientSeq = -1);
+    bool drawCardsForSeat(GameState* g, int seatIndex, int count, QString* error);
+    bool playCardForSeat(GameState* g, int playerIndex, const QString& card, const QString& chosenColor, QString* error);
+    void addBot(QTcpSocket* sock, const QString& code, bool strong);
+    void scheduleBotTurn(GameState* g);
+    void runBotTurn(const QString& code);
+    void finishStrongBotTurn(const QString& code, int seatIndex, const IsmctsResult& result);
+    BotMove heuristicBotMove(const GameState* g, int seatIndex) const;
+    void applyBotMove(GameState* g, int seatIndex, const QString& card, const QString& chosenColor);
+    void removeGameIfIdle(const QString& code);
     void declareUno(QTcpSocket* sock);
+    void spectateGame(QTcpSocket* sock, const QString& code);
+    void resumeSession(QTcpSocket* sock, const QString& token, quint64 lastSeq);
+    QJsonObject resumeSnapshot(GameState* g, int seatIndex) const;
+    void removeGame(const QString& code);
+    bool checkAdmin(QTcpSocket* sock, const QJsonObject& msg);
+    void migrateGame(QTcpSocket* sock, const QString& code, const QString& host, quint16 port);
+    void finishMigration(const QString& code, const QString& host, quint16 port);
+    void abortMigration(const QString& code);
+    void importGame(QTcpSocket* sock, const QByteArray& snapshot);
+    GameState* installGame(const GameState& game);
+    void takeOver();
+    void beginHandOver(int channel);
+    void completeHandOver(int channel);
+    void skipAbandonedSeats(GameState* g);
+    int nextActiveSeat(const GameState* g, int fromIndex) const;
+    int activeSeatCount(const GameState* g) const;
 
-    QStringList buildDeckFromStaticList() const;
+    void broadcast(GameState* g, const QJsonObject& obj);
+    void publishToSpectators(GameState* g, const QByteArray& payload, bool supersedable, QTcpSocket* target = nullptr);
+    void scheduleSpectatorFlush(qint64 delayMs);
+    void flushSpectators();
+    QJsonObject publicState(GameState* g) const;
+
+    static const QStringList& fullDeck();
     void shuffle(QStringList& list) const;
     void sendStateUpdate(GameState* g, const QString& lastPlayedCard = QString(), int playedBy = -1);
     int indexOfPlayer(GameState* g, QTcpSocket* sock) const;
     bool isCardLegal(const QString& card, const QString& topDiscard, const QString& currentColor) const;
-    int advanceIndex(int startIndex, int steps, int direction, int playerCount) const;
-    QStringList drawCardsToPlayer(GameState* g, QTcpSocket* sock, int count);
+    QStringList drawCardsToPlayer(GameState* g, int seatIndex, int count);
     void refillDeck(GameState* g);
     void appendLog(GameState* g, const QString& event, int playerIndex, const QString& detail);
     void applyUnoPenaltyIfNeeded(GameState* g, int currentPlayerIndex);
 
 private:
+    ServerConfig m_config;
+    ServerMetrics m_metrics;
     QTcpServer m_server;
-    QHash<QTcpSocket*, QByteArray> m_buffers;
+    FdHandoffListener m_handoff;                // nur im Worker-Modus
+    ConsistentHashRing m_ring;                  // Code -> Worker, gleich wie im Router
+    HotRestartListener m_hotRestart;
+    bool m_handingOver = false;                 // Übergabe an Nachfolger läuft, nichts mehr lesen
+    QTimer m_housekeepingTimer;
+    QTimer m_pingTimer;
+    QElapsedTimer m_clock;
+    QHash<QTcpSocket*, ConnectionState> m_connections;
+    QHash<QString, IpState> m_ipStates;
 
     QHash<QString, GameState> m_games;
     QHash<QTcpSocket*, QString> m_socketToGame;
+    QHash<QTcpSocket*, QString> m_spectatorToGame;
+    QHash<QString, QString> m_resumeTokens;     // Token -> Spielcode
+
+    Matchmaker m_matchmaker;
+    QTimer m_matchmakingTimer;
+
+    QTimer m_spectatorTimer;
+    QSet<QString> m_gamesWithSpectatorEvents;
 };
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+
+// Laufzeit-Einstellungen des Servers (Defaults hier, überschreibbar in main.cpp)
+struct ServerConfig {
+    quint16 port = 12345;
+
+    // Backpressure pro Verbindung, gemessen an bytesToWrite() des Sockets:
+    // über High = langsamer Client (state_updates werden zusammengefasst),
+    // unter Low = wieder normal, über HardLimit = Verbindung wird getrennt.
+    qint64 outHighWatermark = 256 * 1024;
+    qint64 outLowWatermark = 64 * 1024;
+    qint64 outHardLimit = 2 * 1024 * 1024;
+    int slowConsumerTimeoutMs = 10000;
+
+    // Rate-Limit für eingehende Nachrichten (Token-Bucket, 0 = unbegrenzt).
+    // Über dem Limit werden keine Daten mehr vom Socket gelesen, bis wieder Tokens da sind.
+    double msgRatePerConnection = 20.0;
+    double msgBurstPerConnection = 40.0;
+    double msgRatePerIp = 60.0;
+    double msgBurstPerIp = 120.0;
+    qint64 readBufferSize = 64 * 1024;
+
+    // Maximale Länge einer Nachricht (eine Zeile bis '\n'). Größere Frames schließen die Verbindung.
+    int maxFrameSize = 16 * 1024;
+
+    // Verzögerung des Zuschauer-Streams in ms (0 = live)
+    int spectatorDelayMs = 0;
+
+    // Matchmaking: alle intervalMs werden bis zu batchSize Tische gebildet und gestartet
+    int matchmakingIntervalMs = 250;
+    int matchmakingBatchSize = 64;
+    int matchmakingRatingBucket = 200;
+
+    // Nach einem Verbindungsabbruch bleibt der Platz so lange reserviert (Reconnect per Token)
+    int seatGraceMs = 60000;
+    int resumeEventBacklog = 64;
+
+    // Latenzmessung: alle pingIntervalMs ein ping an jede Verbindung (0 = aus).
+    // Der Client antwortet mit pong, daraus werden RTT und Uhrenabweichung bestimmt.
+    int pingIntervalMs = 2000;
+
+    // Bots: Wartezeit vor einem Bot-Zug (0 = sofort, z.B. für Lasttests) und ob
+    // ein Bot den Platz übernimmt, wenn die Reservierung eines Spielers abläuft
+    int botMoveDelayMs = 800;
+    bool botReplacesDisconnected = true;
+
+    // Starke Bots (add_bot mit level "strong"): Rechenzeit pro Zug und Threads pro Suche
+    // (0 = alle Kerne). Alle Suchen teilen sich einen eigenen, auf die Kerne begrenzten Pool;
+    // wenige Threads pro Suche lassen mehrere starke Bots gleichzeitig rechnen.
+    int strongBotBudgetMs = 300;
+    int strongBotThreads = 2;
+
+    // Mehrere Prozesse: ein Router (--router) nimmt auf port an und reicht jede Verbindung
+    // nach der ersten Nachricht an den Worker weiter, dem der Spielcode gehört.
+    // workerIndex >= 0 macht diesen Prozess zum Worker, Übergabe-Socket = Prefix-Index.sock
+    int workerCount = 0;
+    int workerIndex = -1;
+    QString workerSocketPrefix = "/tmp/unoserver-worker";
+    int ringVirtualNodes = 64;
+    int routerFirstMessageTimeoutMs = 10000;
+
+    // Live-Migration: Admin-Befehle (migrate_game/import_game) nur mit diesem Token,
+    // leer = abgeschaltet. Angemeldete Admin-Verbindungen dürfen große Frames schicken.
+    QString adminToken;
+    int maxAdminFrameSize = 8 * 1024 * 1024;
+    int migrationTimeoutMs = 5000;
+
+    // Hot-Restart: controlSocket = eigener Kontrollsocket für den Nachfolger (leer = aus),
+    // takeoverFrom = Kontrollsocket des Vorgängers, von dem beim Start übernommen wird
+    QString controlSocket;
+    QString takeoverFrom;
+    int handoverDrainMs = 2000;
+};
@@ -0,0 +1,20 @@
+# Nebenläufigkeitstest für das geshardete Spiele-Register (qmake && make check)
+QT += core testlib
+QT -= gui
+CONFIG += console c++17 testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+TARGET = tst_gamemanager
+
+include(../../../unorules/unorules.pri)
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_gamemanager.cpp \
+    $$PWD/../../gamemanager.cpp
+
+HEADERS += \
+    $$PWD/../../clientconnection.h \
+    $$PWD/../../gamemanager.h
@@ -0,0 +1,162 @@
+#include <QtTest>
+#include <QThread>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "cardcatalog.h"
+#include "gamemanager.h"
+
+namespace {
+
+constexpr int ThreadCount = 8;
+constexpr int GamesPerThread = 500;
+constexpr int PlayersPerThread = 1000;
+
+// GameManager speichert Spieler nur als Zeiger; für den Test reichen eindeutige Adressen
+char playerSlots[ThreadCount * PlayersPerThread + 1];
+
+ClientConnection* fakePlayer(int index)
+{
+    return reinterpret_cast<ClientConnection*>(&playerSlots[index]);
+}
+
+// Startet fn(threadIndex) in ThreadCount Threads gleichzeitig und wartet auf alle
+template <typename Fn>
+void runThreads(Fn fn)
+{
+    std::atomic<bool> go{false};
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back(QThread::create([&go, fn, t]() {
+            while (!go.load(std::memory_order_acquire))
+                QThread::yieldCurrentThread();
+            fn(t);
+        }));
+        threads.back()->start();
+    }
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads)
+        thread->wait();
+}
+
+} // namespace
+
+class TestGameManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void createLookupRemove();
+    void concurrentCreateLookupRemove();
+    void concurrentAddPlayer();
+    void gameOutlivesRemoval();
+    void startGameDealsHands();
+};
+
+void TestGameManager::createLookupRemove()
+{
+    GameManager manager;
+    QVERIFY(manager.createGame("ABCD", fakePlayer(0)));
+    QVERIFY(!manager.createGame("ABCD", fakePlayer(1)));
+    QCOMPARE(manager.gameCount(), 1);
+
+    const std::shared_ptr<Game> g = manager.getGame("ABCD");
+    QVERIFY(g);
+    QCOMPARE(g->code, QString("ABCD"));
+    QCOMPARE(g->host, fakePlayer(0));
+
+    QVERIFY(!manager.getGame("WXYZ"));
+    QVERIFY(manager.removeGame("ABCD"));
+    QVERIFY(!manager.removeGame("ABCD"));
+    QCOMPARE(manager.gameCount(), 0);
+}
+
+//Jeder Thread legt eigene Codes an, liest fremde und entfernt jeden zweiten wieder
+void TestGameManager::concurrentCreateLookupRemove()
+{
+    GameManager manager;
+    std::atomic<int> failures{0};
+
+    runThreads([&manager, &failures](int t) {
+        for (int i = 0; i < GamesPerThread; ++i) {
+            const QString code = QStringLiteral("T%1G%2").arg(t).arg(i);
+            if (!manager.createGame(code, fakePlayer(t)))
+                ++failures;
+            const std::shared_ptr<Game> g = manager.getGame(code);
+            if (!g || g->code != code)
+                ++failures;
+
+            // Lesezugriffe auf Codes anderer Threads, die es geben kann oder nicht
+            manager.getGame(QStringLiteral("T%1G%2").arg((t + 1) % ThreadCount).arg(i));
+
+            if (i % 2 == 1 && !manager.removeGame(code))
+                ++failures;
+        }
+    });
+
+    QCOMPARE(failures.load(), 0);
+    QCOMPARE(manager.gameCount(), ThreadCount * GamesPerThread / 2);
+    for (int t = 0; t < ThreadCount; ++t) {
+        QVERIFY(manager.getGame(QStringLiteral("T%1G0").arg(t)));
+        QVERIFY(!manager.getGame(QStringLiteral("T%1G1").arg(t)));
+    }
+}
+
+//Alle Threads schreiben in dasselbe Spiel; Game::mutex muss jeden Eintrag erhalten
+void TestGameManager::concurrentAddPlayer()
+{
+    GameManager manager;
+    const int hostIndex = ThreadCount * PlayersPerThread;
+    QVERIFY(manager.createGame("SHARED", fakePlayer(hostIndex)));
+
+    std::atomic<int> failures{0};
+    runThreads([&manager, &failures](int t) {
+        for (int i = 0; i < PlayersPerThread; ++i) {
+            if (!manager.addPlayer("SHARED", fakePlayer(t * PlayersPerThread + i)))
+                ++failures;
+        }
+    });
+
+    QCOMPARE(failures.load(), 0);
+    int players = 0;
+    QVERIFY(manager.withGame("SHARED", [&players](Game& g) { players = int(g.players.size()); }));
+    QCOMPARE(players, ThreadCount * PlayersPerThread + 1);
+}
+
+void TestGameManager::gameOutlivesRemoval()
+{
+    GameManager manager;
+    QVERIFY(manager.createGame("KEEP", fakePlayer(0)));
+    const std::shared_ptr<Game> g = manager.getGame("KEEP");
+    QVERIFY(manager.removeGame("KEEP"));
+
+    // Wer das Spiel noch hält, kann es weiter benutzen; neu nachschlagen findet es nicht mehr
+    QVERIFY(!manager.getGame("KEEP"));
+    QCOMPARE(g->code, QString("KEEP"));
+    QVERIFY(!manager.addPlayer("KEEP", fakePlayer(1)));
+}
+
+void TestGameManager::startGameDealsHands()
+{
+    GameManager manager;
+    QVERIFY(manager.createGame("PLAY", fakePlayer(0)));
+    QVERIFY(manager.addPlayer("PLAY", fakePlayer(1)));
+
+    QString error;
+    QVERIFY2(manager.startGame("PLAY", &error), qPrintable(error));
+    QVERIFY(!manager.startGame("PLAY", &error));
+    QCOMPARE(error, QString("Game already started"));
+
+    manager.withGame("PLAY", [](Game& g) {
+        QCOMPARE(int(g.hands.size()), 2);
+        for (const QStringList& hand : std::as_const(g.hands))
+            QCOMPARE(int(hand.size()), 6);
+        QCOMPARE(int(g.discard.size()), 1);
+        QCOMPARE(int(g.deck.size()), CardCatalog::CardCount - 2 * 6 - 1);
+    });
+}
+
+QTEST_GUILESS_MAIN(TestGameManager)
+#include "tst_gamemanager.moc"
@@ -0,0 +1,46 @@
+#include "tokenbucket.h"
+
+#include <QtMath>
+
+TokenBucket::TokenBucket(double ratePerSec, double burst)
+    : m_rate(ratePerSec), m_burst(qMax(1.0, burst)), m_tokens(qMax(1.0, burst))
+{
+}
+
+//Füllt die Tokens anhand der vergangenen Zeit wieder auf
+void TokenBucket::refill(qint64 nowMs)
+{
+    if (m_lastMs < 0) {
+        m_lastMs = nowMs;
+        return;
+    }
+    const qint64 elapsed = nowMs - m_lastMs;
+    if (elapsed <= 0)
+        return;
+    m_tokens = qMin(m_burst, m_tokens + elapsed * m_rate / 1000.0);
+    m_lastMs = nowMs;
+}
+
+//Prüft, ob mindestens ein Token vorhanden ist (ohne es zu verbrauchen)
+bool TokenBucket::available(qint64 nowMs)
+{
+    if (unlimited())
+        return true;
+    refill(nowMs);
+    return m_tokens >= 1.0;
+}
+
+//Verbraucht ein Token, vorher muss available() geprüft werden
+void TokenBucket::consume()
+{
+    if (!unlimited())
+        m_tokens -= 1.0;
+}
+
+//Wie lange es dauert, bis wieder ein Token da ist
+qint64 TokenBucket::msUntilAvailable(qint64 nowMs)
+{
+    if (available(nowMs))
+        return 0;
+    return qint64(qCeil((1.0 - m_tokens) * 1000.0 / m_rate));
+}
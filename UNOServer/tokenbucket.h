@@ -0,0 +1,24 @@
+#pragma once
+
+#include <QtGlobal>
+
+// Einfacher Token-Bucket: füllt sich mit ratePerSec auf, maximal burst Tokens.
+// ratePerSec <= 0 bedeutet unbegrenzt. Zeit kommt von außen (monotone Millisekunden).
+class TokenBucket {
+public:
+    TokenBucket() = default;
+    TokenBucket(double ratePerSec, double burst);
+
+    bool unlimited() const { return m_rate <= 0.0; }
+    bool available(qint64 nowMs);
+    void consume();
+    qint64 msUntilAvailable(qint64 nowMs);
+
+private:
+    void refill(qint64 nowMs);
+
+    double m_rate = 0.0;
+    double m_burst = 0.0;
+    double m_tokens = 0.0;
+    qint64 m_lastMs = -1;
+};
@@ -0,0 +1,515 @@
+#include "clientcore.h"
+
+#include <QDateTime>
+#include <QJsonArray>
+
+#include <utility>
+
+#include "rules.h"
+
+namespace {
+QList<int> toIntList(const QJsonArray& arr)
+{
+    QList<int> out;
+    out.reserve(arr.size());
+    for (const QJsonValue& v : arr) out << v.toInt();
+    return out;
+}
+
+QStringList toStringList(const QJsonArray& arr)
+{
+    QStringList out;
+    out.reserve(arr.size());
+    for (const QJsonValue& v : arr) out << v.toString();
+    return out;
+}
+}
+
+ClientCore::ClientCore(Callbacks callbacks) : m_callbacks(std::move(callbacks)) {}
+
+quint32 ClientCore::takeChanges()
+{
+    const quint32 changes = m_changes;
+    m_changes = 0;
+    return changes;
+}
+
+void ClientCore::handleMessage(const QJsonObject& o)
+{
+    handleMessage(serverMessageFromType(o.value("type").toString()), o, QDateTime::currentMSecsSinceEpoch());
+}
+
+//Wendet eine Server-Nachricht auf den gespeicherten Stand an
+void ClientCore::handleMessage(ServerMessage message, const QJsonObject& o, qint64 receivedMs)
+{
+    if (o.contains("seq"))
+        m_lastSeq = qMax(m_lastSeq, quint64(o.value("seq").toDouble()));
+
+    // Latenzmessung des Servers: Empfangs- und Sendezeit mitschicken, damit die Wartezeit
+    // bis zum nächsten Frame nicht als Netzwerk-RTT zählt
+    if (message == ServerMessage::Ping) {
+        send(QJsonObject{
+            {"type","pong"},
+            {"id", o.value("id")},
+            {"clientRecv", double(receivedMs)},
+            {"clientSend", double(QDateTime::currentMSecsSinceEpoch())}
+        });
+        return;
+    }
+
+    if (message == ServerMessage::Latency) {
+        m_latency.rttMs = o.value("rttMs").toDouble(-1.0);
+        m_latency.smoothedRttMs = o.value("smoothedRttMs").toDouble(m_latency.rttMs);
+        m_latency.clockOffsetMs = o.value("clockOffsetMs").toDouble();
+        m_latency.samples = o.value("samples").toInt();
+        m_latency.rttP50Ms = o.value("rttP50Ms").toDouble(-1.0);
+        m_latency.rttP95Ms = o.value("rttP95Ms").toDouble(-1.0);
+        m_latency.rttP99Ms = o.value("rttP99Ms").toDouble(-1.0);
+        m_latency.processingP95Ms = o.value("processingP95Ms").toDouble(-1.0);
+        m_changes |= LatencyChanged;
+        return;
+    }
+
+    if (message == ServerMessage::Error) {
+        // Resume abgelehnt (Platz abgelaufen): Token verwerfen, kein weiterer Versuch
+        if (m_awaitingResume) {
+            m_awaitingResume = false;
+            m_resumeToken.clear();
+        }
+        // Abgelehnter vorhergesagter Zug: ihn und alle späteren zurücknehmen
+        if (o.contains("clientSeq")) {
+            const quint32 seq = quint32(o.value("clientSeq").toDouble());
+            for (int i = 0; i < m_pending.size(); ++i) {
+                if (m_pending.at(i).seq == seq) {
+                    rollbackFrom(i);
+                    break;
+                }
+            }
+        }
+        error(o.value("message").toString());
+        return;
+    }
+
+    // Spiel zieht auf einen anderen Server um: sofort neu verbinden und Platz per Token übernehmen.
+    // Mit retry (Code gehört einem anderen Worker): nach dem Verbinden genau diese Anfrage wiederholen
+    if (message == ServerMessage::Redirect) {
+        const QString token = o.value("token").toString();
+        if (!token.isEmpty())
+            m_resumeToken = token;
+        m_redirectRetry = o.value("retry").toObject();
+        m_reconnectAttempts = 0;
+        m_reconnecting = true;
+        if (m_callbacks.redirect)
+            m_callbacks.redirect(o.value("host").toString(), o.value("port").toInt());
+        if (m_redirectRetry.isEmpty())
+            info("Spiel wird auf einen anderen Server verschoben...");
+        return;
+    }
+
+    if (message == ServerMessage::GameCreated || message == ServerMessage::JoinOk
+        || message == ServerMessage::QueueOk || message == ServerMessage::MatchFound) {
+        if (m_callbacks.lobby)
+            m_callbacks.lobby(message, o);
+        return;
+    }
+
+    if (message == ServerMessage::GameInit) {
+        m_pending.clear();
+        setField(m_state.hasGameInit, true, HasGameInitChanged);
+        setField(m_state.spectating, false, SpectatingChanged);
+        setField(m_state.gameCode, o.value("code").toString(), GameCodeChanged);
+        setField(m_state.discardTop, o.value("discardTop").toString(), DiscardTopChanged);
+        setField(m_state.drawCount, o.value("drawCount").toInt(), DrawCountChanged);
+        setField(m_state.players, o.value("players").toInt(), PlayersChanged);
+        setField(m_state.yourIndex, o.value("yourIndex").toInt(), YourIndexChanged);
+        setField(m_state.currentPlayerIndex, o.value("currentPlayerIndex").toInt(), CurrentPlayerIndexChanged);
+        setField(m_state.currentColor, o.value("currentColor").toString(), CurrentColorChanged);
+        m_state.direction = o.value("direction").toInt(1);
+        setField(m_state.finished, o.value("finished").toBool(false), FinishedChanged);
+        setField(m_state.winnerIndex, -1, WinnerIndexChanged);
+        setField(m_state.gameLog, QString(), GameLogChanged);
+        m_resumeToken = o.value("resumeToken").toString();
+        m_lastSeq = quint64(o.value("seq").toDouble());
+
+        setHand(o);
+        setField(m_state.handCounts, toIntList(o.value("handCounts").toArray()), HandCountsChanged);
+        historyReset();
+        historyAppend();
+
+        info(QString("game_init: hand=%1 discard=%2").arg(m_hand.count()).arg(m_state.discardTop));
+        return;
+    }
+
+    // Snapshot nach Reconnect: ersetzt den lokalen Stand, Token bleibt gleich
+    if (message == ServerMessage::ResumeOk) {
+        m_awaitingResume = false;
+        // Snapshot enthält alle Züge, die der Server angenommen hat
+        m_pending.clear();
+        // Verlauf nur behalten, wenn es noch dasselbe Spiel ist
+        const bool sameGame = m_state.hasGameInit && m_state.gameCode == o.value("code").toString();
+        m_reconnectAttempts = 0;
+        setField(m_state.hasGameInit, true, HasGameInitChanged);
+        setField(m_state.gameCode, o.value("code").toString(), GameCodeChanged);
+        setField(m_state.discardTop, o.value("discardTop").toString(), DiscardTopChanged);
+        setField(m_state.drawCount, o.value("drawCount").toInt(), DrawCountChanged);
+        setField(m_state.players, o.value("players").toInt(), PlayersChanged);
+        setField(m_state.yourIndex, o.value("yourIndex").toInt(), YourIndexChanged);
+        setField(m_state.currentPlayerIndex, o.value("currentPlayerIndex").toInt(), CurrentPlayerIndexChanged);
+        setField(m_state.currentColor, o.value("currentColor").toString(), CurrentColorChanged);
+        m_state.direction = o.value("direction").toInt(1);
+        setField(m_state.finished, o.value("finished").toBool(false), FinishedChanged);
+        m_lastSeq = quint64(o.value("seq").toDouble());
+
+        setHand(o);
+        setField(m_state.handCounts, toIntList(o.value("handCounts").toArray()), HandCountsChanged);
+        if (!sameGame)
+            historyReset();
+        historyAppend();
+
+        info("Wieder verbunden.");
+        return;
+    }
+
+    if (message == ServerMessage::BotAdded) {
+        info(QString("Bot hinzugefügt (%1 Spieler).").arg(o.value("players").toInt()));
+        return;
+    }
+
+    if (message == ServerMessage::PlayerReplaced) {
+        info(QString("Ein Bot spielt jetzt für Spieler %1.").arg(o.value("playerIndex").toInt() + 1));
+        return;
+    }
+
+    if (message == ServerMessage::PlayerDisconnected) {
+        info(QString("Spieler %1 hat die Verbindung verloren.").arg(o.value("playerIndex").toInt() + 1));
+        return;
+    }
+
+    if (message == ServerMessage::PlayerReconnected) {
+        info(QString("Spieler %1 ist wieder da.").arg(o.value("playerIndex").toInt() + 1));
+        return;
+    }
+
+    if (message == ServerMessage::PlayerLeft) {
+        info(QString("Spieler %1 hat das Spiel verlassen.").arg(o.value("playerIndex").toInt() + 1));
+        return;
+    }
+
+    // Zuschauer: öffentlicher Stand ohne eigene Hand
+    if (message == ServerMessage::SpectateOk) {
+        // Erneutes Zuschauen nach Reconnect/Umzug: Verlauf behalten
+        const bool sameGame = m_state.hasGameInit && m_state.spectating && m_state.gameCode == o.value("code").toString();
+        m_pending.clear();
+        setField(m_state.hasGameInit, true, HasGameInitChanged);
+        setField(m_state.spectating, true, SpectatingChanged);
+        setField(m_state.gameCode, o.value("code").toString(), GameCodeChanged);
+        setField(m_state.discardTop, o.value("discardTop").toString(), DiscardTopChanged);
+        setField(m_state.drawCount, o.value("drawCount").toInt(), DrawCountChanged);
+        setField(m_state.players, o.value("players").toInt(), PlayersChanged);
+        setField(m_state.yourIndex, -1, YourIndexChanged);
+        setField(m_state.currentPlayerIndex, o.value("currentPlayerIndex").toInt(), CurrentPlayerIndexChanged);
+        setField(m_state.currentColor, o.value("currentColor").toString(), CurrentColorChanged);
+        m_state.direction = o.value("direction").toInt(1);
+        setField(m_state.finished, o.value("finished").toBool(false), FinishedChanged);
+        setField(m_state.winnerIndex, -1, WinnerIndexChanged);
+        setField(m_state.gameLog, QString(), GameLogChanged);
+        m_hand.clear();
+        m_changes |= HandChanged;
+        m_hand.setPlayContext(m_state.discardTop, m_state.currentColor);
+
+        setField(m_state.handCounts, toIntList(o.value("handCounts").toArray()), HandCountsChanged);
+        if (!sameGame)
+            historyReset();
+        historyAppend();
+
+        info(QString("spectate_ok: %1").arg(m_state.gameCode));
+        return;
+    }
+
+    if (message == ServerMessage::CardsDrawn) {
+        const QStringList drawn = toStringList(o.value("cards").toArray());
+        m_hand.appendCards(drawn);
+        m_changes |= HandChanged;
+        setField(m_state.drawCount, o.value("drawCount").toInt(), DrawCountChanged);
+        setField(m_state.currentPlayerIndex, o.value("currentPlayerIndex").toInt(), CurrentPlayerIndexChanged);
+
+        info(QString("cards_drawn: +%1").arg(drawn.size()));
+        return;
+    }
+
+    if (message == ServerMessage::StateUpdate) {
+        setField(m_state.discardTop, o.value("discardTop").toString(), DiscardTopChanged);
+        setField(m_state.drawCount, o.value("drawCount").toInt(), DrawCountChanged);
+        setField(m_state.currentPlayerIndex, o.value("currentPlayerIndex").toInt(), CurrentPlayerIndexChanged);
+        setField(m_state.currentColor, o.value("currentColor").toString(), CurrentColorChanged);
+        setField(m_state.finished, o.value("finished").toBool(false), FinishedChanged);
+        if (o.contains("players"))
+            setField(m_state.players, o.value("players").toInt(), PlayersChanged);
+        m_state.direction = o.value("direction").toInt(m_state.direction);
+
+        setField(m_state.handCounts, toIntList(o.value("handCounts").toArray()), HandCountsChanged);
+        historyAppend();
+
+        // Noch unbestätigte eigene Züge liegen zeitlich nach diesem Stand: wieder darüberlegen
+        for (PendingMove& move : m_pending)
+            applyPrediction(move);
+        m_hand.setPlayContext(m_state.discardTop, m_state.currentColor);
+        return;
+    }
+
+    if (message == ServerMessage::CardPlayed) {
+        const int playerIndex = o.value("playerIndex").toInt();
+        const QString card = o.value("card").toString();
+        if (playerIndex == m_state.yourIndex) {
+            // Bestätigung des ältesten vorhergesagten Zugs: Karte ist schon aus der Hand
+            if (!m_pending.isEmpty() && m_pending.first().card == card) {
+                const double ms = qMax(0.0, double(receivedMs - m_pending.first().sentMs));
+                m_latency.moveLatencyMs = m_latency.moveLatencyMs < 0 ? ms
+                                          : m_latency.moveLatencyMs + (ms - m_latency.moveLatencyMs) / 8.0;
+                m_changes |= LatencyChanged;
+                m_pending.removeFirst();
+            } else if (m_hand.removeCard(card)) {
+                m_changes |= HandChanged;
+            }
+        }
+        return;
+    }
+
+    if (message == ServerMessage::GameFinished) {
+        setField(m_state.finished, true, FinishedChanged);
+        setField(m_state.winnerIndex, o.value("winnerIndex").toInt(-1), WinnerIndexChanged);
+        setField(m_state.gameLog, o.value("logCsv").toString(), GameLogChanged);
+        return;
+    }
+
+    info("Server msg: " + o.value("type").toString());
+}
+
+//Komplette Hand aus game_init/resume_ok
+void ClientCore::setHand(const QJsonObject& o)
+{
+    m_hand.setPlayContext(m_state.discardTop, m_state.currentColor);
+    m_hand.setCards(toStringList(o.value("hand").toArray()));
+    m_changes |= HandChanged;
+}
+
+void ClientCore::onConnected()
+{
+    // Messwerte gelten nur für eine Verbindung
+    m_latency = LatencyStats();
+    m_changes |= LatencyChanged;
+
+    // Nach einem Abbruch: Platz mit Token übernehmen, Server schickt verpasste Events + Snapshot
+    if (m_reconnecting) {
+        m_reconnecting = false;
+        if (!m_redirectRetry.isEmpty()) {
+            m_awaitingResume = m_redirectRetry.value("type").toString() == "resume";
+            send(std::exchange(m_redirectRetry, QJsonObject()));
+        } else if (m_state.spectating) {
+            send(QJsonObject{{"type","spectate_game"},{"code",m_state.gameCode}});
+        } else {
+            m_awaitingResume = true;
+            send(QJsonObject{{"type","resume"},{"token",m_resumeToken},{"lastSeq",double(m_lastSeq)}});
+        }
+    }
+}
+
+int ClientCore::onDisconnected(bool userInitiated)
+{
+    // Ob unbestätigte Züge angekommen sind, zeigt erst der Snapshot nach dem Resume
+    rollbackFrom(0);
+    if (!userInitiated && !m_resumeToken.isEmpty() && m_state.hasGameInit && !m_state.finished)
+        return nextReconnectDelay();
+    return -1;
+}
+
+int ClientCore::onConnectFailed()
+{
+    // Fehlgeschlagener Reconnect-Versuch (kein disconnected, da nie verbunden)
+    return m_reconnecting ? nextReconnectDelay() : -1;
+}
+
+void ClientCore::stopReconnecting()
+{
+    m_reconnecting = false;
+    m_redirectRetry = QJsonObject();
+}
+
+//Nächste Pause vor einem Reconnect-Versuch (1s, 2s, 4s ... max 8s, höchstens 10 Versuche)
+int ClientCore::nextReconnectDelay()
+{
+    if (m_reconnectAttempts >= MaxReconnectAttempts) {
+        m_reconnecting = false;
+        error("Verbindung verloren.");
+        return -1;
+    }
+    m_reconnecting = true;
+    const int delayMs = qMin(8000, 1000 << qMin(m_reconnectAttempts, 3));
+    ++m_reconnectAttempts;
+    return delayMs;
+}
+
+qint64 ClientCore::nextDeadlineMs() const
+{
+    return m_pending.isEmpty() ? -1 : m_pending.first().sentMs + PredictionTimeoutMs;
+}
+
+//Keine Antwort auf einen vorhergesagten Zug: lieber zurücknehmen als falsch stehen lassen
+void ClientCore::expirePredictions(qint64 nowMs)
+{
+    const qint64 deadline = nextDeadlineMs();
+    if (deadline < 0 || nowMs < deadline)
+        return;
+    rollbackFrom(0);
+    error("Keine Antwort vom Server, Zug zurückgenommen.");
+}
+
+void ClientCore::createGame()
+{
+    send(QJsonObject{{"type","create_game"}});
+}
+
+void ClientCore::joinGame(const QString& code)
+{
+    send(QJsonObject{{"type","join_game"},{"code",code.trimmed().toUpper()}});
+}
+
+void ClientCore::startGame(const QString& code)
+{
+    send(QJsonObject{{"type","start_game"},{"code",code.trimmed().toUpper()}});
+}
+
+void ClientCore::addBot(const QString& code, bool strong)
+{
+    QJsonObject msg{{"type","add_bot"},{"code",code.trimmed().toUpper()}};
+    if (strong)
+        msg.insert("level", "strong");
+    send(msg);
+}
+
+void ClientCore::spectateGame(const QString& code)
+{
+    send(QJsonObject{{"type","spectate_game"},{"code",code.trimmed().toUpper()}});
+}
+
+void ClientCore::queueJoin(int tableSize)
+{
+    send(QJsonObject{{"type","queue_join"},{"size",tableSize}});
+}
+
+void ClientCore::queueLeave()
+{
+    send(QJsonObject{{"type","queue_leave"}});
+}
+
+void ClientCore::drawCards(int count)
+{
+    if (count < 1) count = 1;
+    if (count > 10) count = 10;
+    send(QJsonObject{{"type","draw_cards"},{"count",count}});
+}
+
+void ClientCore::playCard(const QString& card, const QString& chosenColor)
+{
+    QJsonObject payload{{"type","play_card"},{"card",card}};
+    if (!chosenColor.isEmpty()) {
+        payload.insert("chosenColor", chosenColor);
+    }
+
+    // Lokal gültige Züge sofort zeigen; der Server bestätigt per card_played oder lehnt per error ab
+    PendingMove move;
+    move.seq = ++m_clientSeq;
+    move.card = card;
+    move.chosenColor = chosenColor.trimmed();
+    if (predictPlay(move)) {
+        move.sentMs = QDateTime::currentMSecsSinceEpoch();
+        m_pending.append(move);
+        payload.insert("clientSeq", double(move.seq));
+    }
+    send(payload);
+}
+
+void ClientCore::declareUno()
+{
+    send(QJsonObject{{"type","declare_uno"}});
+}
+
+//Prüft den Zug mit denselben Regeln wie der Server und wendet ihn an; false = nicht vorhersagbar
+bool ClientCore::predictPlay(PendingMove& move)
+{
+    const ClientState& s = m_state;
+    if (!s.hasGameInit || s.spectating || s.finished || s.yourIndex < 0 || s.currentPlayerIndex != s.yourIndex)
+        return false;
+
+    move.cardIndex = CardCatalog::indexOf(move.card);
+    if (move.cardIndex < 0)
+        return false;
+    const int topIndex = s.discardTop.isEmpty() ? -1 : CardCatalog::indexOf(s.discardTop);
+    if (!CardCatalog::isLegal(move.cardIndex, topIndex, CardCatalog::colorFromName(s.currentColor)))
+        return false;
+    if (UnoRules::needsChosenColor(move.cardIndex)
+        && !UnoRules::isPlayableColor(CardCatalog::colorFromName(move.chosenColor)))
+        return false;
+
+    move.handRow = m_hand.takeCard(move.card);
+    if (move.handRow < 0)
+        return false;
+    m_changes |= HandChanged;
+
+    applyPrediction(move);
+    m_hand.setPlayContext(s.discardTop, s.currentColor);
+    return true;
+}
+
+//Öffentlicher Teil eines Zugs (Ablage, Farbe, Richtung, Zug, Kartenanzahl); merkt sich den Stand davor
+void ClientCore::applyPrediction(PendingMove& move)
+{
+    move.discardTop = m_state.discardTop;
+    move.currentColor = m_state.currentColor;
+    move.currentPlayerIndex = m_state.currentPlayerIndex;
+    move.direction = m_state.direction;
+    move.handCounts = m_state.handCounts;
+
+    setField(m_state.discardTop, move.card, DiscardTopChanged);
+    if (UnoRules::needsChosenColor(move.cardIndex))
+        setField(m_state.currentColor, move.chosenColor, CurrentColorChanged);
+    else
+        setField(m_state.currentColor, QString(CardCatalog::colorName(CardCatalog::card(move.cardIndex).color)), CurrentColorChanged);
+
+    const int players = m_state.players;
+    const UnoRules::PlayEffect effect = UnoRules::effectOf(move.cardIndex, players);
+    if (effect.reverse)
+        m_state.direction = -m_state.direction;
+
+    QList<int> counts = m_state.handCounts;
+    if (m_state.yourIndex < counts.size())
+        counts[m_state.yourIndex] = qMax(0, counts.at(m_state.yourIndex) - 1);
+    if (effect.drawCount > 0) {
+        const int target = UnoRules::advanceIndex(m_state.currentPlayerIndex, 1, m_state.direction, players);
+        if (target < counts.size())
+            counts[target] += effect.drawCount;
+    }
+    setField(m_state.handCounts, counts, HandCountsChanged);
+    setField(m_state.currentPlayerIndex,
+             UnoRules::advanceIndex(m_state.currentPlayerIndex, effect.advanceSteps, m_state.direction, players),
+             CurrentPlayerIndexChanged);
+}
+
+//Nimmt den Zug an pendingIndex und alle späteren zurück, neueste zuerst
+void ClientCore::rollbackFrom(int pendingIndex)
+{
+    if (pendingIndex < 0 || pendingIndex >= m_pending.size())
+        return;
+    for (int i = m_pending.size() - 1; i >= pendingIndex; --i) {
+        const PendingMove& move = m_pending.at(i);
+        setField(m_state.discardTop, move.discardTop, DiscardTopChanged);
+        setField(m_state.currentColor, move.currentColor, CurrentColorChanged);
+        setField(m_state.currentPlayerIndex, move.currentPlayerIndex, CurrentPlayerIndexChanged);
+        setField(m_state.handCounts, move.handCounts, HandCountsChanged);
+        m_state.direction = move.direction;
+        m_hand.insertCard(move.handRow, move.card);
+        m_changes |= HandChanged;
+    }
+    m_pending.remove(pendingIndex, m_pending.size() - pendingIndex);
+    m_hand.setPlayContext(m_state.discardTop, m_state.currentColor);
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+
+#include "clienthand.h"
+#include "protocol.h"
+
+// Öffentlicher Spielstand aus Sicht eines Clients
+struct ClientState {
+    bool hasGameInit = false;
+    QString gameCode;
+    QString discardTop;
+    int drawCount = 0;
+    int players = 0;
+    int yourIndex = -1;
+    int currentPlayerIndex = 0;
+    int direction = 1;
+    QList<int> handCounts;
+    QString currentColor;
+    bool finished = false;
+    int winnerIndex = -1;
+    QString gameLog;
+    bool spectating = false;
+};
+
+// Latenzwerte: RTT & Co. aus der "latency"-Nachricht des Servers, moveLatencyMs misst der
+// Client selbst (play_card gesendet -> card_played empfangen, gleitend gemittelt)
+struct LatencyStats {
+    double rttMs = -1.0;
+    double smoothedRttMs = -1.0;
+    double clockOffsetMs = 0.0;
+    int samples = 0;
+    double rttP50Ms = -1.0;
+    double rttP95Ms = -1.0;
+    double rttP99Ms = -1.0;
+    double processingP95Ms = -1.0;
+    double moveLatencyMs = -1.0;
+};
+
+// Protokoll und Spielstand eines Clients ohne GUI, ohne QObject und ohne eigenen Socket.
+// Der Transport (Qt-Client: NetworkWorker, Lasttests: eigener Socket) reicht geparste
+// Nachrichten an handleMessage weiter und verschickt, was über callbacks.send rauskommt.
+// Geänderte Felder sammeln sich als Bits und werden mit takeChanges() abgeholt, so kann
+// ein Adapter einmal pro Frame melden und ein Bot einfach gar nicht.
+//
+// Eigene Züge werden vorhergesagt: playCard wendet einen lokal gültigen Zug sofort an,
+// ein error mit derselben clientSeq nimmt ihn (und alle späteren) zurück.
+class ClientCore
+{
+public:
+    enum Change : quint32 {
+        HasGameInitChanged        = 1u << 0,
+        GameCodeChanged           = 1u << 1,
+        DiscardTopChanged         = 1u << 2,
+        DrawCountChanged          = 1u << 3,
+        PlayersChanged            = 1u << 4,
+        YourIndexChanged          = 1u << 5,
+        CurrentPlayerIndexChanged = 1u << 6,
+        HandCountsChanged         = 1u << 7,
+        CurrentColorChanged       = 1u << 8,
+        FinishedChanged           = 1u << 9,
+        WinnerIndexChanged        = 1u << 10,
+        GameLogChanged            = 1u << 11,
+        SpectatingChanged         = 1u << 12,
+        HandChanged               = 1u << 13,
+        LatencyChanged            = 1u << 14,
+    };
+
+    struct Callbacks {
+        std::function<void(const QJsonObject&)> send;           // Nachricht an den Server
+        std::function<void(const QString&)> info;
+        std::function<void(const QString&)> error;
+        // Lobby-Antworten (GameCreated, JoinOk, QueueOk, MatchFound) mit der Nachricht
+        std::function<void(ServerMessage, const QJsonObject&)> lobby;
+        // Spiel zieht um: Transport soll sofort zu host:port neu verbinden (Resume läuft dann von selbst)
+        std::function<void(const QString& host, int port)> redirect;
+        // Verlauf der Kartenanzahl (Graph am Spielende)
+        std::function<void(int players)> historyReset;
+        std::function<void(const QList<int>& counts)> historyAppend;
+    };
+
+    static constexpr int PredictionTimeoutMs = 5000;
+    static constexpr int MaxReconnectAttempts = 10;
+
+    explicit ClientCore(Callbacks callbacks = Callbacks());
+
+    const ClientState& state() const { return m_state; }
+    const LatencyStats& latency() const { return m_latency; }
+    ClientHand& hand() { return m_hand; }
+    const ClientHand& hand() const { return m_hand; }
+    bool hasPendingMoves() const { return !m_pending.isEmpty(); }
+
+    // Seit dem letzten Aufruf geänderte Felder (Change-Bits), danach wieder 0
+    quint32 takeChanges();
+
+    // Eingehende Nachrichten; receivedMs = Empfangszeit (Epoch-ms) für ping/pong
+    void handleMessage(ServerMessage message, const QJsonObject& o, qint64 receivedMs);
+    void handleMessage(const QJsonObject& o);
+
+    // Verbindung: Transport meldet, Core entscheidet über Resume und Reconnect-Pausen
+    void onConnected();
+    int onDisconnected(bool userInitiated);     // Pause bis zum Reconnect in ms, -1 = nicht neu verbinden
+    int onConnectFailed();                      // dito, nach einem fehlgeschlagenen Verbindungsversuch
+    void stopReconnecting();
+
+    // Vorhersagen ohne Antwort zurücknehmen; nextDeadlineMs = Epoch-ms der nächsten Frist, -1 = keine
+    qint64 nextDeadlineMs() const;
+    void expirePredictions(qint64 nowMs);
+
+    // Befehle an den Server
+    void createGame();
+    void joinGame(const QString& code);
+    void startGame(const QString& code);
+    void addBot(const QString& code, bool strong = false);
+    void spectateGame(const QString& code);
+    void queueJoin(int tableSize = 2);
+    void queueLeave();
+    void drawCards(int count = 1);
+    void playCard(const QString& card, const QString& chosenColor = QString());
+    void declareUno();
+
+private:
+    struct PendingMove {
+        quint32 seq = 0;
+        QString card;
+        int cardIndex = -1;
+        QString chosenColor;
+        int handRow = -1;               // Zeile in der Hand, in die die Karte zurückkommt
+        qint64 sentMs = 0;              // Epoch-ms beim Senden, für moveLatencyMs
+        // Öffentlicher Stand vor dem Zug
+        QString discardTop;
+        QString currentColor;
+        int currentPlayerIndex = 0;
+        int direction = 1;
+        QList<int> handCounts;
+    };
+
+    // Markiert ein Feld als geändert, wenn sich der Wert wirklich unterscheidet
+    template <typename T>
+    void setField(T& field, const T& value, quint32 change)
+    {
+        if (field == value)
+            return;
+        field = value;
+        m_changes |= change;
+    }
+
+    void send(const QJsonObject& o) const { if (m_callbacks.send) m_callbacks.send(o); }
+    void info(const QString& msg) const { if (m_callbacks.info) m_callbacks.info(msg); }
+    void error(const QString& msg) const { if (m_callbacks.error) m_callbacks.error(msg); }
+    void historyReset() const { if (m_callbacks.historyReset) m_callbacks.historyReset(m_state.players); }
+    void historyAppend() const { if (m_callbacks.historyAppend) m_callbacks.historyAppend(m_state.handCounts); }
+
+    void setHand(const QJsonObject& o);
+    int nextReconnectDelay();
+
+    bool predictPlay(PendingMove& move);
+    void applyPrediction(PendingMove& move);
+    void rollbackFrom(int pendingIndex);
+
+    Callbacks m_callbacks;
+    ClientState m_state;
+    LatencyStats m_latency;
+    ClientHand m_hand;
+    quint32 m_changes = 0;
+
+    // Reconnect: nach einem ungewollten Abbruch wird mit dem Token aus game_init der alte Platz übernommen
+    QString m_resumeToken;
+    quint64 m_lastSeq = 0;
+    bool m_reconnecting = false;
+    bool m_awaitingResume = false;
+    int m_reconnectAttempts = 0;
+    QJsonObject m_redirectRetry;                // nach einem redirect erneut zu sendende Anfrage
+
+    // Noch nicht bestätigte eigene Züge, älteste zuerst
+    QList<PendingMove> m_pending;
+    quint32 m_clientSeq = 0;
+};
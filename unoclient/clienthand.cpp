@@ -0,0 +1,102 @@
+#include "clienthand.h"
+
+QStringList ClientHand::cards() const
+{
+    QStringList out;
+    out.reserve(m_cards.size());
+    for (const Card& c : m_cards)
+        out << c.id;
+    return out;
+}
+
+void ClientHand::setCards(const QStringList& cards)
+{
+    if (m_listener) m_listener->handAboutToReset();
+    m_cards.clear();
+    m_cards.reserve(cards.size());
+    for (const QString& id : cards)
+        m_cards.append(makeCard(id));
+    if (m_listener) m_listener->handReset();
+}
+
+//Neue Karten kommen hinten dazu, ein Insert pro Schub
+void ClientHand::appendCards(const QStringList& cards)
+{
+    if (cards.isEmpty())
+        return;
+    const int first = m_cards.size();
+    if (m_listener) m_listener->handAboutToInsert(first, first + cards.size() - 1);
+    for (const QString& id : cards)
+        m_cards.append(makeCard(id));
+    if (m_listener) m_listener->handInserted();
+}
+
+bool ClientHand::removeCard(const QString& cardId)
+{
+    return takeCard(cardId) >= 0;
+}
+
+//Entfernt die erste passende Karte und liefert ihre Zeile (-1 = nicht auf der Hand)
+int ClientHand::takeCard(const QString& cardId)
+{
+    for (int row = 0; row < m_cards.size(); ++row) {
+        if (m_cards.at(row).id != cardId)
+            continue;
+        if (m_listener) m_listener->handAboutToRemove(row);
+        m_cards.removeAt(row);
+        if (m_listener) m_listener->handRemoved();
+        return row;
+    }
+    return -1;
+}
+
+void ClientHand::insertCard(int row, const QString& cardId)
+{
+    row = qBound(0, row, int(m_cards.size()));
+    if (m_listener) m_listener->handAboutToInsert(row, row);
+    m_cards.insert(row, makeCard(cardId));
+    if (m_listener) m_listener->handInserted();
+}
+
+void ClientHand::clear()
+{
+    if (m_cards.isEmpty())
+        return;
+    if (m_listener) m_listener->handAboutToReset();
+    m_cards.clear();
+    if (m_listener) m_listener->handReset();
+}
+
+void ClientHand::setPlayContext(const QString& discardTop, const QString& currentColor)
+{
+    if (discardTop == m_discardTop && currentColor == m_currentColor)
+        return;
+    m_discardTop = discardTop;
+    m_currentColor = currentColor;
+    m_topIndex = discardTop.isEmpty() ? -1 : CardCatalog::indexOf(discardTop);
+    m_color = CardCatalog::colorFromName(currentColor);
+
+    for (int row = 0; row < m_cards.size(); ++row) {
+        Card& card = m_cards[row];
+        const bool playable = isPlayable(card.index);
+        if (playable == card.playable)
+            continue;
+        card.playable = playable;
+        if (m_listener) m_listener->handPlayableChanged(row);
+    }
+}
+
+ClientHand::Card ClientHand::makeCard(const QString& cardId) const
+{
+    Card card;
+    card.id = cardId;
+    card.index = CardCatalog::indexOf(cardId);
+    card.playable = isPlayable(card.index);
+    return card;
+}
+
+//Gleiche Regel wie Server::isCardLegal (gemeinsamer CardCatalog aus unorules)
+bool ClientHand::isPlayable(int cardIndex) const
+{
+    return CardCatalog::isLegal(cardIndex, m_topIndex, m_color);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include "cardcatalog.h"
+
+// Eigene Hand mit Spielbarkeit pro Karte (gleiche Regel wie der Server). Gezogene/gelegte
+// Karten fügen genau eine Zeile ein bzw. entfernen sie. Ein optionaler Listener bekommt
+// jede Änderung einzeln (HandModel macht daraus Model-Signale); ohne Listener kostet das nichts.
+class ClientHand
+{
+public:
+    struct Card {
+        QString id;
+        int index = -1;         // CardCatalog-Index, einmal beim Einfügen bestimmt
+        bool playable = false;
+    };
+
+    // Vorher/Nachher-Paare, wie sie QAbstractItemModel braucht
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+        virtual void handAboutToReset() = 0;
+        virtual void handReset() = 0;
+        virtual void handAboutToInsert(int first, int last) = 0;
+        virtual void handInserted() = 0;
+        virtual void handAboutToRemove(int row) = 0;
+        virtual void handRemoved() = 0;
+        virtual void handPlayableChanged(int row) = 0;
+    };
+
+    void setListener(Listener* listener) { m_listener = listener; }
+
+    int count() const { return m_cards.size(); }
+    const Card& at(int row) const { return m_cards.at(row); }
+    QStringList cards() const;
+
+    // Komplette Hand (game_init, resume_ok) – einziger Fall mit Reset
+    void setCards(const QStringList& cards);
+    void appendCards(const QStringList& cards);
+    bool removeCard(const QString& cardId);
+    // Für vorhergesagte Züge: Zeile merken und beim Zurücknehmen an derselben Stelle wieder einfügen
+    int takeCard(const QString& cardId);
+    void insertCard(int row, const QString& cardId);
+    void clear();
+
+    // Ablage oder Farbe hat sich geändert: nur Zeilen mit geändertem playable melden
+    void setPlayContext(const QString& discardTop, const QString& currentColor);
+
+private:
+    Card makeCard(const QString& cardId) const;
+    bool isPlayable(int cardIndex) const;
+
+    QList<Card> m_cards;
+    Listener* m_listener = nullptr;
+    QString m_discardTop;
+    QString m_currentColor;
+    int m_topIndex = -1;
+    CardCatalog::Color m_color = CardCatalog::Color::None;
+};
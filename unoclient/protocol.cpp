@@ -0,0 +1,30 @@
+#include "protocol.h"
+
+#include <QHash>
+
+ServerMessage serverMessageFromType(const QString& type)
+{
+    static const QHash<QString, ServerMessage> types{
+        {"error", ServerMessage::Error},
+        {"redirect", ServerMessage::Redirect},
+        {"game_created", ServerMessage::GameCreated},
+        {"join_ok", ServerMessage::JoinOk},
+        {"queue_ok", ServerMessage::QueueOk},
+        {"match_found", ServerMessage::MatchFound},
+        {"game_init", ServerMessage::GameInit},
+        {"resume_ok", ServerMessage::ResumeOk},
+        {"bot_added", ServerMessage::BotAdded},
+        {"player_replaced", ServerMessage::PlayerReplaced},
+        {"player_disconnected", ServerMessage::PlayerDisconnected},
+        {"player_reconnected", ServerMessage::PlayerReconnected},
+        {"player_left", ServerMessage::PlayerLeft},
+        {"spectate_ok", ServerMessage::SpectateOk},
+        {"cards_drawn", ServerMessage::CardsDrawn},
+        {"state_update", ServerMessage::StateUpdate},
+        {"card_played", ServerMessage::CardPlayed},
+        {"game_finished", ServerMessage::GameFinished},
+        {"ping", ServerMessage::Ping},
+        {"latency", ServerMessage::Latency},
+    };
+    return types.value(type, ServerMessage::Unknown);
+}
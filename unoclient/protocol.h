@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+
+// Nachrichtentypen des Servers, aus dem Feld "type" bestimmt. Der Qt-Client macht das
+// schon im Netzwerk-Thread, headless Nutzer über ClientCore::handleMessage(QJsonObject).
+enum class ServerMessage : quint8 {
+    Unknown,
+    Error,
+    Redirect,
+    GameCreated,
+    JoinOk,
+    QueueOk,
+    MatchFound,
+    GameInit,
+    ResumeOk,
+    BotAdded,
+    PlayerReplaced,
+    PlayerDisconnected,
+    PlayerReconnected,
+    PlayerLeft,
+    SpectateOk,
+    CardsDrawn,
+    StateUpdate,
+    CardPlayed,
+    GameFinished,
+    Ping,
+    Latency,
+};
+
+ServerMessage serverMessageFromType(const QString& type);
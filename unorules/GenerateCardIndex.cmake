@@ -0,0 +1,128 @@
+# Erzeugt cardindex.h (constexpr-Kartentabelle für CardCatalog) aus den Kartenbildern.
+#
+#   cmake -DCARDS_DIR=<assets/images/cards> -DOUTPUT=<.../cardindex.h> [-DRESOURCE_PREFIX=:/assets/images/cards] -P GenerateCardIndex.cmake
+#
+# Dateinamen: <Farbe>_<Wert>.<jpg|jpeg|png>, Farbe = Rot|Gruen|Blau|Gelb|Extra,
+# Wert = 1..9 | Sperre | Richtungswechsel | Farbwechsel | 4plus. "Gegnerkarte" ist die Rückseite.
+# Reihenfolge der Indizes: Zahlen (Farbe, Wert), Sperren, Richtungswechsel, Farbwechsel, +4 –
+# dieselbe wie vorher von Hand, damit Indizes in Snapshots und Bots gleich bleiben.
+
+cmake_minimum_required(VERSION 3.16)
+
+if(NOT CARDS_DIR OR NOT OUTPUT)
+    message(FATAL_ERROR "GenerateCardIndex: CARDS_DIR und OUTPUT angeben")
+endif()
+if(NOT DEFINED RESOURCE_PREFIX)
+    set(RESOURCE_PREFIX ":/assets/images/cards")
+endif()
+
+file(GLOB files RELATIVE "${CARDS_DIR}" "${CARDS_DIR}/*")
+list(SORT files)
+
+set(colors Rot Gruen Blau Gelb)
+set(entries "")
+set(back "")
+set(seen "")
+
+foreach(file IN LISTS files)
+    if(NOT file MATCHES "^(.+)\\.(jpg|jpeg|png|JPG|JPEG|PNG)$")
+        continue()
+    endif()
+    set(stem "${CMAKE_MATCH_1}")
+    if(stem IN_LIST seen)
+        message(WARNING "GenerateCardIndex: ${file} doppelt, erste Datei gewinnt")
+        continue()
+    endif()
+    list(APPEND seen "${stem}")
+
+    if(stem STREQUAL "Gegnerkarte")
+        set(back "${file}")
+        continue()
+    endif()
+
+    if(NOT stem MATCHES "^(Rot|Gruen|Blau|Gelb|Extra)_(.+)$")
+        message(FATAL_ERROR "GenerateCardIndex: unbekannte Karte ${file}")
+    endif()
+    set(color "${CMAKE_MATCH_1}")
+    set(value "${CMAKE_MATCH_2}")
+
+    # Sortierschlüssel: Gruppe, Farbe, Wert (alles zweistellig, damit SORT stimmt)
+    list(FIND colors "${color}" colorRank)
+    if(colorRank LESS 0)
+        set(colorRank 9)
+    endif()
+    if(value MATCHES "^[1-9]$")
+        set(group 0)
+        set(enumValue "N${value}")
+        set(valueRank "0${value}")
+    elseif(value STREQUAL "Sperre")
+        set(group 1)
+        set(enumValue Skip)
+        set(valueRank 10)
+    elseif(value STREQUAL "Richtungswechsel")
+        set(group 2)
+        set(enumValue Reverse)
+        set(valueRank 11)
+    elseif(value STREQUAL "Farbwechsel" AND color STREQUAL "Extra")
+        set(group 3)
+        set(enumValue ColorChange)
+        set(valueRank 12)
+    elseif(value STREQUAL "4plus" AND color STREQUAL "Extra")
+        set(group 4)
+        set(enumValue DrawFour)
+        set(valueRank 13)
+    else()
+        message(FATAL_ERROR "GenerateCardIndex: unbekannter Wert in ${file}")
+    endif()
+    if(color STREQUAL "Extra" AND group LESS 3)
+        message(FATAL_ERROR "GenerateCardIndex: ${file} ist keine Extra-Karte")
+    endif()
+
+    list(APPEND entries "${group}${colorRank}${valueRank}|${file}|${color}|${enumValue}")
+endforeach()
+
+list(SORT entries)
+list(LENGTH entries count)
+if(count EQUAL 0)
+    message(FATAL_ERROR "GenerateCardIndex: keine Karten in ${CARDS_DIR}")
+endif()
+
+set(rows "")
+foreach(entry IN LISTS entries)
+    string(REPLACE "|" ";" parts "${entry}")
+    list(GET parts 1 file)
+    list(GET parts 2 color)
+    list(GET parts 3 enumValue)
+    string(APPEND rows "    {\"${file}\", Color::${color}, Value::${enumValue}, \"${RESOURCE_PREFIX}/${file}\"},\n")
+endforeach()
+
+if(back STREQUAL "")
+    set(backResource "")
+else()
+    set(backResource "${RESOURCE_PREFIX}/${back}")
+endif()
+
+set(content "// Generiert von unorules/GenerateCardIndex.cmake aus den Kartenbildern – nicht von Hand ändern.
+#pragma once
+
+namespace CardCatalog {
+
+inline constexpr int CardCount = ${count};
+
+inline constexpr Card Cards[CardCount] = {
+${rows}};
+
+// Rückseite (Gegnerkarte), leer wenn kein Bild vorhanden
+inline constexpr const char BackResource[] = \"${backResource}\";
+
+} // namespace CardCatalog
+")
+
+# Nur schreiben, wenn sich etwas geändert hat: sonst baut jeder Lauf alles neu
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" old)
+    if(old STREQUAL content)
+        return()
+    endif()
+endif()
+file(WRITE "${OUTPUT}" "${content}")
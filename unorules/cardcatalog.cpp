@@ -0,0 +1,56 @@
+#include "cardcatalog.h"
+
+namespace CardCatalog {
+
+//Sucht die Karte per Namen (linear über 46 Einträge, ohne Allokation)
+int indexOf(QStringView cardName)
+{
+    for (int i = 0; i < CardCount; ++i) {
+        if (cardName == QLatin1StringView(Cards[i].name))
+            return i;
+    }
+    return -1;
+}
+
+Color colorFromName(QStringView colorName)
+{
+    if (colorName == QLatin1StringView("Rot")) return Color::Rot;
+    if (colorName == QLatin1StringView("Gruen")) return Color::Gruen;
+    if (colorName == QLatin1StringView("Blau")) return Color::Blau;
+    if (colorName == QLatin1StringView("Gelb")) return Color::Gelb;
+    return Color::None;
+}
+
+QLatin1StringView colorName(Color color)
+{
+    switch (color) {
+    case Color::Rot: return QLatin1StringView("Rot");
+    case Color::Gruen: return QLatin1StringView("Gruen");
+    case Color::Blau: return QLatin1StringView("Blau");
+    case Color::Gelb: return QLatin1StringView("Gelb");
+    case Color::Extra: return QLatin1StringView("Extra");
+    case Color::None: break;
+    }
+    return QLatin1StringView();
+}
+
+//Farbe oder Wert müssen passen, Extra-Karten gehen immer. Liegt eine Extra-Karte oben, zählt die gewählte Farbe
+bool isLegal(int cardIndex, int topIndex, Color currentColor)
+{
+    if (topIndex < 0)
+        return true;
+    if (cardIndex < 0)
+        return false;
+
+    const Card& play = Cards[cardIndex];
+    if (play.color == Color::Extra)
+        return true;
+
+    const Card& top = Cards[topIndex];
+    if (top.color == Color::Extra)
+        return currentColor != Color::None && play.color == currentColor;
+
+    return play.color == top.color || play.value == top.value;
+}
+
+} // namespace CardCatalog
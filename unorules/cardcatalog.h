@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QLatin1StringView>
+#include <QStringView>
+#include <QtGlobal>
+
+// Feste Liste aller Karten. Karten werden intern über ihren Index (0..CardCount-1)
+// angesprochen, damit Regeln und Bots ohne String-Zerlegung und ohne Heap auskommen.
+// Die Tabelle selbst (Cards, CardCount, BackResource) erzeugt der Build aus den
+// Kartenbildern in StartTest/assets/images/cards, siehe GenerateCardIndex.cmake.
+namespace CardCatalog {
+
+enum class Color : quint8 { Rot, Gruen, Blau, Gelb, Extra, None };
+enum class Value : quint8 { N1 = 1, N2, N3, N4, N5, N6, N7, N8, N9, Skip, Reverse, ColorChange, DrawFour };
+
+struct Card {
+    const char* name;                           // Karten-ID wie im Protokoll, z.B. "Rot_5.jpg"
+    Color color;
+    Value value;
+    const char* resource;                       // Qt-Ressource des Bildes, z.B. ":/assets/images/cards/Rot_5.jpg"
+};
+
+} // namespace CardCatalog
+
+#include "cardindex.h"
+
+namespace CardCatalog {
+
+// Handmasken (quint64) brauchen ein Bit pro Karte
+static_assert(CardCount > 0 && CardCount <= 64, "Kartentabelle passt nicht in eine 64-Bit-Maske");
+
+inline const Card& card(int index)
+{
+    Q_ASSERT(index >= 0 && index < CardCount);
+    return Cards[index];
+}
+inline QLatin1StringView name(int index) { return QLatin1StringView(card(index).name); }
+inline QLatin1StringView resource(int index) { return QLatin1StringView(card(index).resource); }
+int indexOf(QStringView name);                  // -1 = unbekannte Karte
+Color colorFromName(QStringView colorName);     // "Rot", "Gruen", ... sonst None
+QLatin1StringView colorName(Color color);
+
+inline bool isWild(int index) { return card(index).color == Color::Extra; }
+
+// Gleiche Regel wie Server::isCardLegal: topIndex < 0 bedeutet leere Ablage
+bool isLegal(int cardIndex, int topIndex, Color currentColor);
+
+} // namespace CardCatalog
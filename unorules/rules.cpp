@@ -0,0 +1,53 @@
+#include "rules.h"
+
+namespace UnoRules {
+
+using CardCatalog::Color;
+using CardCatalog::Value;
+
+//Erhöht den Index bei mehreren Personen
+int advanceIndex(int startIndex, int steps, int direction, int playerCount)
+{
+    if (playerCount <= 0)
+        return 0;
+    int idx = startIndex;
+    for (int i = 0; i < steps; ++i) {
+        idx = (idx + direction) % playerCount;
+        if (idx < 0) idx += playerCount;
+    }
+    return idx;
+}
+
+//+4 und Sperre überspringen einen Platz, Richtungswechsel wirkt zu zweit wie eine Sperre
+PlayEffect effectOf(int cardIndex, int playerCount)
+{
+    PlayEffect effect;
+    if (cardIndex < 0)
+        return effect;
+
+    switch (CardCatalog::card(cardIndex).value) {
+    case Value::DrawFour:
+        effect.drawCount = 4;
+        effect.advanceSteps = 2;
+        break;
+    case Value::Skip:
+        effect.advanceSteps = 2;
+        break;
+    case Value::Reverse:
+        effect.reverse = true;
+        effect.advanceSteps = playerCount == 2 ? 2 : 1;
+        break;
+    default:
+        break;
+    }
+    return effect;
+}
+
+Color startColor(int topIndex)
+{
+    if (topIndex < 0 || CardCatalog::isWild(topIndex))
+        return Color::Rot;
+    return CardCatalog::card(topIndex).color;
+}
+
+} // namespace UnoRules
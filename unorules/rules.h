@@ -0,0 +1,28 @@
+#pragma once
+
+#include "cardcatalog.h"
+
+// Zugregeln, die Server, Bots (FastGame) und Client gemeinsam benutzen.
+// Alles arbeitet auf Kartenindizes aus CardCatalog, ohne Strings und ohne Heap.
+namespace UnoRules {
+
+// Nächster Platz in Spielrichtung, steps Plätze weiter
+int advanceIndex(int startIndex, int steps, int direction, int playerCount);
+
+// Was eine gelegte Karte mit dem Zug macht
+struct PlayEffect {
+    bool reverse = false;       // Richtung umdrehen (vor dem Weiterrücken)
+    int advanceSteps = 1;       // so viele Plätze rückt der Zug weiter
+    int drawCount = 0;          // der nächste Spieler zieht so viele Karten
+};
+
+PlayEffect effectOf(int cardIndex, int playerCount);
+
+// Farbe nach dem Aufdecken der ersten Karte (Extra-Karte oben -> Rot)
+CardCatalog::Color startColor(int topIndex);
+
+// Extra-Karten brauchen eine gewählte Farbe aus Rot/Gruen/Blau/Gelb
+inline bool needsChosenColor(int cardIndex) { return cardIndex >= 0 && CardCatalog::isWild(cardIndex); }
+inline bool isPlayableColor(CardCatalog::Color color) { return color < CardCatalog::Color::Extra; }
+
+} // namespace UnoRules
@@ -0,0 +1,24 @@
+# Gemeinsame UNO-Regeln (Kartenkatalog, Legalität, Zugfolge) für UNOServer.
+# StartTest baut dieselben Quellen über unorules/CMakeLists.txt als statische Bibliothek.
+
+# Kartentabelle aus den Kartenbildern erzeugen (dasselbe Skript wie im CMake-Build).
+# qmake läuft nicht bei jedem Build: nach neuen Bildern qmake erneut ausführen.
+UNO_CARDS_DIR = $$clean_path($$PWD/../StartTest/assets/images/cards)
+UNO_GENERATED_DIR = $$OUT_PWD/generated
+!system(cmake \
+        -DCARDS_DIR=$$shell_quote($$UNO_CARDS_DIR) \
+        -DOUTPUT=$$shell_quote($$UNO_GENERATED_DIR/cardindex.h) \
+        -P $$shell_quote($$PWD/GenerateCardIndex.cmake)) {
+    error("unorules: cardindex.h konnte nicht erzeugt werden (cmake im PATH?)")
+}
+
+INCLUDEPATH += $$PWD $$UNO_GENERATED_DIR
+DEPENDPATH += $$PWD
+
+SOURCES += \
+    $$PWD/cardcatalog.cpp \
+    $$PWD/rules.cpp
+
+HEADERS += \
+    $$PWD/cardcatalog.h \
+    $$PWD/rules.h